@@ -0,0 +1,141 @@
+#include "DisplayList.h"
+
+#include "Renderer.h"
+
+void DisplayList::reset() {
+  count = 0;
+  arenaUsed = 0;
+  overflow = false;
+}
+
+void DisplayList::add(Op op, int16_t x, int16_t y, int16_t w, int16_t h, ColorToken color) {
+  if (count >= kMaxCommands) {
+    overflow = true;
+    return;
+  }
+  DrawCommand &cmd = commands[count++];
+  cmd.op = op;
+  cmd.color = color;
+  cmd.scale = 0;
+  cmd.textLen = 0;
+  cmd.textOffset = 0;
+  cmd.x = x;
+  cmd.y = y;
+  cmd.w = w;
+  cmd.h = h;
+}
+
+void DisplayList::addText(int16_t x, int16_t y, int16_t w, int16_t h, const char *text, uint8_t scale,
+                          ColorToken color) {
+  size_t len = strlen(text);
+  if (count >= kMaxCommands || len > 255 || arenaUsed + len > kArenaBytes) {
+    overflow = true;
+    return;
+  }
+  add(OP_TEXT, x, y, w, h, color);
+  DrawCommand &cmd = commands[count - 1];
+  cmd.scale = scale;
+  cmd.textLen = static_cast<uint8_t>(len);
+  cmd.textOffset = arenaUsed;
+  memcpy(arena + arenaUsed, text, len);
+  arenaUsed += len;
+}
+
+void DisplayList::addShape(Op op, int16_t x, int16_t y, int16_t w, int16_t h, const int16_t *params,
+                           uint8_t paramCount, ColorToken color) {
+  addData(op, x, y, w, h, params, paramCount * sizeof(int16_t), color);
+}
+
+void DisplayList::addBlit(int16_t x, int16_t y, int16_t w, int16_t h, const FramePixel *pixels, int16_t stride,
+                          uint16_t revision) {
+  // Cleared first so padding compares equal in matches().
+  BlitSource source;
+  memset(&source, 0, sizeof(source));
+  source.pixels = pixels;
+  source.stride = stride;
+  source.revision = revision;
+  addData(OP_BLIT, x, y, w, h, &source, sizeof(source), BG_PRIMARY);
+}
+
+void DisplayList::addData(Op op, int16_t x, int16_t y, int16_t w, int16_t h, const void *data, size_t len,
+                          ColorToken color) {
+  if (count >= kMaxCommands || arenaUsed + len > kArenaBytes) {
+    overflow = true;
+    return;
+  }
+  add(op, x, y, w, h, color);
+  DrawCommand &cmd = commands[count - 1];
+  cmd.textLen = static_cast<uint8_t>(len);
+  cmd.textOffset = arenaUsed;
+  memcpy(arena + arenaUsed, data, len);
+  arenaUsed += len;
+}
+
+bool DisplayList::matches(uint16_t i, const DisplayList &other) const {
+  if (i >= count || i >= other.count) return false;
+  const DrawCommand &a = commands[i];
+  const DrawCommand &b = other.commands[i];
+  if (a.op != b.op || a.color != b.color || a.scale != b.scale || a.textLen != b.textLen) return false;
+  if (a.x != b.x || a.y != b.y || a.w != b.w || a.h != b.h) return false;
+  return memcmp(arena + a.textOffset, other.arena + b.textOffset, a.textLen) == 0;
+}
+
+void DisplayList::replay(Renderer &renderer, int16_t x, int16_t y, int16_t w, int16_t h) const {
+  char text[256];
+  int16_t p[6];
+  BlitSource source;
+  renderer.setClip(x, y, w, h);
+  for (uint16_t i = 0; i < count; ++i) {
+    const DrawCommand &cmd = commands[i];
+    if (cmd.x >= x + w || cmd.y >= y + h || cmd.x + cmd.w <= x || cmd.y + cmd.h <= y) continue;
+    ColorToken color = static_cast<ColorToken>(cmd.color);
+    switch (cmd.op) {
+      case OP_CLEAR:
+        renderer.clear(color);
+        break;
+      case OP_FILL:
+        renderer.fillRect(cmd.x, cmd.y, cmd.w, cmd.h, color);
+        break;
+      case OP_HLINE:
+        renderer.drawHLine(cmd.x, cmd.y, cmd.w, color);
+        break;
+      case OP_VLINE:
+        renderer.drawVLine(cmd.x, cmd.y, cmd.h, color);
+        break;
+      case OP_TEXT:
+        memcpy(text, arena + cmd.textOffset, cmd.textLen);
+        text[cmd.textLen] = '\0';
+        renderer.drawText(cmd.x, cmd.y, text, cmd.scale, color);
+        break;
+      case OP_CIRCLE:
+        memcpy(p, arena + cmd.textOffset, cmd.textLen);
+        renderer.fillCircle(p[0], p[1], p[2], color);
+        break;
+      case OP_ARC:
+        memcpy(p, arena + cmd.textOffset, cmd.textLen);
+        renderer.fillArc(p[0], p[1], p[2], p[3], p[4], p[5], color);
+        break;
+      case OP_ROUND_RECT:
+        memcpy(p, arena + cmd.textOffset, cmd.textLen);
+        renderer.fillRoundRect(cmd.x, cmd.y, cmd.w, cmd.h, p[0], color);
+        break;
+      case OP_TRIANGLE:
+        memcpy(p, arena + cmd.textOffset, cmd.textLen);
+        renderer.fillTriangle(p[0], p[1], p[2], p[3], p[4], p[5], color);
+        break;
+      case OP_THICK_LINE:
+        memcpy(p, arena + cmd.textOffset, cmd.textLen);
+        renderer.drawThickLine(p[0], p[1], p[2], p[3], p[4], color);
+        break;
+      case OP_BLEND:
+        memcpy(p, arena + cmd.textOffset, cmd.textLen);
+        renderer.blendRect(cmd.x, cmd.y, cmd.w, cmd.h, color, static_cast<BlendAlpha>(p[0]));
+        break;
+      case OP_BLIT:
+        memcpy(&source, arena + cmd.textOffset, sizeof(source));
+        renderer.blit(source.pixels, cmd.x, cmd.y, cmd.w, cmd.h, source.stride, source.revision);
+        break;
+    }
+  }
+  renderer.resetClip();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Palette.h"
+
+class Renderer;
+
+// One recorded Renderer call. x/y/w/h is the call's bounding box in screen
+// coordinates; text commands keep their string and shape commands their
+// int16_t parameters, and blits their BlitSource, in the list's arena
+// (textLen bytes at textOffset).
+struct DrawCommand {
+  uint8_t op;
+  uint8_t color;
+  uint8_t scale;
+  uint8_t textLen;
+  uint16_t textOffset;
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+// Where a recorded blit copies from. Two blits match when they read the
+// same pixels at the same revision.
+struct BlitSource {
+  const FramePixel *pixels;
+  int16_t stride;
+  uint16_t revision;
+};
+
+// A frame's draw calls in paint order. Comparing two lists command by
+// command tells which screen areas can differ between the frames; replay()
+// then rasterizes only those areas.
+class DisplayList {
+public:
+  static const uint16_t kMaxCommands = 256;
+  static const uint16_t kArenaBytes = 1024;
+
+  enum Op : uint8_t {
+    OP_CLEAR,
+    OP_FILL,
+    OP_HLINE,
+    OP_VLINE,
+    OP_TEXT,
+    OP_CIRCLE,
+    OP_ARC,
+    OP_ROUND_RECT,
+    OP_TRIANGLE,
+    OP_THICK_LINE,
+    OP_BLEND,
+    OP_BLIT
+  };
+
+  void reset();
+  void add(Op op, int16_t x, int16_t y, int16_t w, int16_t h, ColorToken color);
+  void addText(int16_t x, int16_t y, int16_t w, int16_t h, const char *text, uint8_t scale, ColorToken color);
+  void addShape(Op op, int16_t x, int16_t y, int16_t w, int16_t h, const int16_t *params, uint8_t paramCount,
+                ColorToken color);
+  void addBlit(int16_t x, int16_t y, int16_t w, int16_t h, const FramePixel *pixels, int16_t stride,
+               uint16_t revision);
+
+  uint16_t size() const { return count; }
+  bool overflowed() const { return overflow; }
+  const DrawCommand &at(uint16_t i) const { return commands[i]; }
+
+  // True when command i draws the same thing in both lists.
+  bool matches(uint16_t i, const DisplayList &other) const;
+
+  // Rasterizes every command touching the rect, clipped to it.
+  void replay(Renderer &renderer, int16_t x, int16_t y, int16_t w, int16_t h) const;
+
+private:
+  void addData(Op op, int16_t x, int16_t y, int16_t w, int16_t h, const void *data, size_t len, ColorToken color);
+
+  DrawCommand commands[kMaxCommands];
+  char arena[kArenaBytes];
+  uint16_t count = 0;
+  uint16_t arenaUsed = 0;
+  bool overflow = false;
+};
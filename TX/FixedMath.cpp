@@ -0,0 +1,56 @@
+#include "FixedMath.h"
+
+namespace FixedMath {
+namespace {
+// sin(0..90 degrees) in Q14.
+const int16_t kSinTable[91] = {
+  0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+  2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+  5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+  8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+  10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+  12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+  14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+  15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+  16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+  16384
+};
+}  // namespace
+
+int32_t sinDeg(int32_t deg) {
+  deg %= 360;
+  if (deg < 0) deg += 360;
+  if (deg <= 90) return kSinTable[deg];
+  if (deg <= 180) return kSinTable[180 - deg];
+  if (deg <= 270) return -kSinTable[deg - 180];
+  return -kSinTable[360 - deg];
+}
+
+uint32_t isqrt(uint32_t value) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > value) bit >>= 2;
+  while (bit) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+int32_t floorDiv(int32_t num, int32_t den) {
+  int32_t q = num / den;
+  if ((num % den != 0) && ((num < 0) != (den < 0))) --q;
+  return q;
+}
+
+int32_t ceilDiv(int32_t num, int32_t den) {
+  int32_t q = num / den;
+  if ((num % den != 0) && ((num < 0) == (den < 0))) ++q;
+  return q;
+}
+}  // namespace FixedMath
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Integer trigonometry for the shape rasterizers: angles are whole degrees,
+// clockwise on screen from +x (y grows downwards), results are Q14.
+namespace FixedMath {
+constexpr int32_t kOne = 1 << 14;
+
+int32_t sinDeg(int32_t deg);
+inline int32_t cosDeg(int32_t deg) { return sinDeg(deg + 90); }
+uint32_t isqrt(uint32_t value);
+// Division rounding towards negative / positive infinity.
+int32_t floorDiv(int32_t num, int32_t den);
+int32_t ceilDiv(int32_t num, int32_t den);
+}  // namespace FixedMath
@@ -0,0 +1,143 @@
+#include "FlushPlanner.h"
+
+bool FlushPlanner::begin(int16_t w, int16_t h, int16_t tw, int16_t th) {
+  int16_t cols = (w + tw - 1) / tw;
+  int16_t rows = (h + th - 1) / th;
+  // Tiles outside the grid could never be flushed; refuse rather than
+  // leave part of the screen stale.
+  if (cols > kMaxTilesX || cols * rows > kMaxTiles) return false;
+  screenW = w;
+  screenH = h;
+  tileW = tw;
+  tileH = th;
+  tilesX = cols;
+  tilesY = rows;
+  reset();
+  return true;
+}
+
+void FlushPlanner::reset() {
+  memset(dirty, 0, sizeof(dirty));
+  dirtyCount = 0;
+}
+
+void FlushPlanner::markTile(int16_t tx, int16_t ty) {
+  if (tx < 0 || ty < 0 || tx >= tilesX || ty >= tilesY) return;
+  uint8_t &cell = dirty[ty * tilesX + tx];
+  if (!cell) {
+    cell = 1;
+    dirtyCount++;
+  }
+}
+
+uint32_t FlushPlanner::rectCost(int16_t cols, int16_t rows) const {
+  uint32_t pxRows = static_cast<uint32_t>(rows) * tileH;
+  uint32_t transactions = (cols == tilesX) ? (pxRows + kChunkRows - 1) / kChunkRows : pxRows;
+  return kRectSetupPx + transactions * kTransSetupPx + pxRows * cols * tileW;
+}
+
+// Collects the dirty runs of one tile row, then bridges gaps and widens to
+// a full-width band whenever the extra pixels cost less than the setup saved.
+uint8_t FlushPlanner::rowSpans(int16_t ty, Span *spans) const {
+  const uint8_t *row = dirty + ty * tilesX;
+  uint8_t count = 0;
+  uint16_t dirtyTiles = 0;
+  for (int16_t tx = 0; tx < tilesX; ++tx) {
+    if (!row[tx]) continue;
+    dirtyTiles++;
+    if (count > 0 && spans[count - 1].tx1 == tx) {
+      spans[count - 1].tx1 = tx + 1;
+    } else {
+      spans[count].tx0 = tx;
+      spans[count].tx1 = tx + 1;
+      count++;
+    }
+  }
+  if (count == 0) return 0;
+
+  uint8_t merged = 0;
+  for (uint8_t i = 1; i < count; ++i) {
+    Span &last = spans[merged];
+    int16_t gap = spans[i].tx0 - last.tx1;
+    uint32_t apart = rectCost(last.tx1 - last.tx0, 1) + rectCost(spans[i].tx1 - spans[i].tx0, 1);
+    uint32_t joined = rectCost(spans[i].tx1 - last.tx0, 1);
+    if (gap > 0 && joined <= apart) {
+      last.tx1 = spans[i].tx1;
+    } else {
+      spans[++merged] = spans[i];
+    }
+  }
+  count = merged + 1;
+
+  uint32_t separate = 0;
+  for (uint8_t i = 0; i < count; ++i) {
+    separate += rectCost(spans[i].tx1 - spans[i].tx0, 1);
+  }
+  if (dirtyTiles < tilesX && rectCost(tilesX, 1) > separate) return count;
+  spans[0].tx0 = 0;
+  spans[0].tx1 = tilesX;
+  return 1;
+}
+
+bool FlushPlanner::emit(const OpenRect &rect, FlushRect *out, uint16_t &count, uint16_t maxRects) const {
+  if (count >= maxRects) return false;
+  FlushRect &r = out[count++];
+  r.x = rect.tx0 * tileW;
+  r.y = rect.ty0 * tileH;
+  r.w = rect.tx1 * tileW > screenW ? screenW - r.x : (rect.tx1 - rect.tx0) * tileW;
+  r.h = (rect.ty0 + rect.rows) * tileH > screenH ? screenH - r.y : rect.rows * tileH;
+  return true;
+}
+
+// Stacks identical spans of consecutive tile rows into one rectangle, so a
+// full-screen change collapses into a single transfer.
+uint16_t FlushPlanner::plan(FlushRect *out, uint16_t maxRects) {
+  uint16_t count = 0;
+  if (!out || maxRects == 0 || dirtyCount == 0) return 0;
+
+  OpenRect open[kMaxTilesX];
+  uint8_t openCount = 0;
+  Span spans[kMaxTilesX];
+
+  for (int16_t ty = 0; ty < tilesY; ++ty) {
+    uint8_t spanCount = rowSpans(ty, spans);
+    for (uint8_t i = 0; i < openCount; ++i) {
+      open[i].extended = false;
+    }
+
+    for (uint8_t s = 0; s < spanCount; ++s) {
+      bool extended = false;
+      for (uint8_t i = 0; i < openCount; ++i) {
+        if (open[i].tx0 == spans[s].tx0 && open[i].tx1 == spans[s].tx1) {
+          open[i].rows++;
+          open[i].extended = true;
+          extended = true;
+          break;
+        }
+      }
+      if (!extended && openCount < kMaxTilesX) {
+        OpenRect &rect = open[openCount++];
+        rect.tx0 = spans[s].tx0;
+        rect.tx1 = spans[s].tx1;
+        rect.ty0 = ty;
+        rect.rows = 1;
+        rect.extended = true;
+      }
+    }
+
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < openCount; ++i) {
+      if (open[i].extended) {
+        open[kept++] = open[i];
+      } else if (!emit(open[i], out, count, maxRects)) {
+        return count;
+      }
+    }
+    openCount = kept;
+  }
+
+  for (uint8_t i = 0; i < openCount; ++i) {
+    if (!emit(open[i], out, count, maxRects)) break;
+  }
+  return count;
+}
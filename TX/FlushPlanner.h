@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "HardwareConfig.h"
+
+struct FlushRect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+// Turns a frame's dirty tiles into a short list of panel rectangles.
+// Costs are in pixel-equivalents: one rect pays the address window setup,
+// every SPI transaction of its pixels pays a transaction setup, and every
+// pixel sent is 1. PanelIO sends a rect one row per transaction, except
+// full-width rects of an RGB565 frame, which go out kChunkRows at a time.
+class FlushPlanner {
+public:
+  static const uint16_t kMaxTiles = 512;
+  // Tiles per row; each row is split into at most this many spans.
+  static const int16_t kMaxTilesX = 64;
+  // What flushsim prints as the planner costs for the shipped ILI9163 at
+  // 26 MHz with ESP-IDF's 13 us per queued transaction; an address window
+  // is five transactions. Re-derive them there when the clock changes.
+  static const uint16_t kRectSetupPx = 105;
+  static const uint16_t kTransSetupPx = 21;
+  // Rows per transaction of a full-width rect; indexed rows are expanded
+  // into a line buffer one at a time.
+  static const int16_t kChunkRows = FRAME_INDEXED ? 1 : 16;
+
+  // False when the tile grid exceeds kMaxTilesX or kMaxTiles.
+  bool begin(int16_t screenW, int16_t screenH, int16_t tileW, int16_t tileH);
+
+  void reset();
+  void markTile(int16_t tx, int16_t ty);
+  bool hasDirty() const { return dirtyCount > 0; }
+
+  // Writes up to maxRects rects to out and returns how many were written.
+  uint16_t plan(FlushRect *out, uint16_t maxRects);
+
+private:
+  struct Span {
+    int16_t tx0;
+    int16_t tx1;
+  };
+
+  struct OpenRect {
+    int16_t tx0;
+    int16_t tx1;
+    int16_t ty0;
+    int16_t rows;
+    bool extended;
+  };
+
+  uint32_t rectCost(int16_t cols, int16_t rows) const;
+  uint8_t rowSpans(int16_t ty, Span *spans) const;
+  bool emit(const OpenRect &rect, FlushRect *out, uint16_t &count, uint16_t maxRects) const;
+
+  int16_t screenW = 0;
+  int16_t screenH = 0;
+  int16_t tileW = 16;
+  int16_t tileH = 16;
+  int16_t tilesX = 0;
+  int16_t tilesY = 0;
+  uint16_t dirtyCount = 0;
+  uint8_t dirty[kMaxTiles];
+};
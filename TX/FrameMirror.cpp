@@ -0,0 +1,196 @@
+#include "FrameMirror.h"
+
+namespace {
+const uint8_t kSync0 = 0xA5;
+const uint8_t kSync1 = 0x5A;
+const uint8_t kHeader = 'H';
+const uint8_t kTile = 'T';
+const uint8_t kFrameEnd = 'F';
+
+// Token kinds, in the top two bits; the low six hold the count minus one.
+const uint8_t kSkip = 0x00;
+const uint8_t kFill = 0x40;
+const uint8_t kLiteral = 0x80;
+const int16_t kMaxRun = 64;
+}  // namespace
+
+bool FrameMirror::begin(int16_t w, int16_t h) {
+  width = w;
+  height = h;
+  tilesX = (w + kTileW - 1) / kTileW;
+  tileCount = tilesX * ((h + kTileH - 1) / kTileH);
+  if (tileCount > kMaxTiles) return false;
+  shadow = static_cast<uint16_t *>(malloc(static_cast<size_t>(w) * h * sizeof(uint16_t)));
+  return shadow != nullptr;
+}
+
+void FrameMirror::markFrame(const FlushRect *rects, uint16_t count) {
+  // Nothing on the panel changed.
+  if (count == 0) return;
+  for (uint16_t i = 0; i < count; ++i) {
+    markRect(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+  }
+  counters.framesFlushed++;
+  if (flushedSinceEnd < 0xFFFF) flushedSinceEnd++;
+  frameOpen = true;
+}
+
+void FrameMirror::markRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (w <= 0 || h <= 0) return;
+  for (int16_t ty = y / kTileH; ty <= (y + h - 1) / kTileH; ++ty) {
+    for (int16_t tx = x / kTileW; tx <= (x + w - 1) / kTileW; ++tx) {
+      pending[ty * tilesX + tx] = 1;
+    }
+  }
+}
+
+void FrameMirror::service(const FramePixel *frame, const uint16_t *lut, uint32_t nowMs) {
+  if (!shadow || !frame) return;
+  while (true) {
+    if (outPos < outLen) {
+      int room = Serial.availableForWrite();
+      if (room <= 0) return;
+      uint16_t chunk = outLen - outPos;
+      if (chunk > room) chunk = static_cast<uint16_t>(room);
+      Serial.write(out + outPos, chunk);
+      outPos += chunk;
+      counters.streamBytes += chunk;
+      if (outPos < outLen) return;
+    }
+    outLen = 0;
+    outPos = 0;
+
+    if (keyframeDue || nowMs - lastKeyframeMs >= kKeyframeMs) {
+      keyframeDue = false;
+      keyframe = true;
+      frameOpen = true;
+      lastKeyframeMs = nowMs;
+      memset(pending, 1, tileCount);
+      beginPacket(kHeader);
+      putWord(width);
+      putWord(height);
+      putByte(kTileW);
+      putByte(kTileH);
+      endPacket();
+      continue;
+    }
+
+    int16_t tile = nextPending();
+    if (tile >= 0) {
+      pending[tile] = 0;
+      if (encodeTile(tile, frame, lut)) counters.tilesSent++;
+      continue;
+    }
+    if (!frameOpen) return;
+    frameOpen = false;
+    keyframe = false;
+    beginPacket(kFrameEnd);
+    putWord(sequence++);
+    putWord(static_cast<uint16_t>(nowMs));
+    putWord(static_cast<uint16_t>(nowMs >> 16));
+    putWord(flushedSinceEnd);
+    endPacket();
+    flushedSinceEnd = 0;
+    counters.framesSent++;
+  }
+}
+
+int16_t FrameMirror::nextPending() {
+  // Resumes after the last tile sent, so a busy top of the screen cannot
+  // starve the rest.
+  for (uint16_t i = 0; i < tileCount; ++i) {
+    uint16_t tile = (cursor + i < tileCount) ? cursor + i : cursor + i - tileCount;
+    if (pending[tile]) {
+      cursor = (tile + 1 < tileCount) ? tile + 1 : 0;
+      return static_cast<int16_t>(tile);
+    }
+  }
+  return -1;
+}
+
+bool FrameMirror::encodeTile(uint16_t tile, const FramePixel *frame, const uint16_t *lut) {
+  int16_t x0 = (tile % tilesX) * kTileW;
+  int16_t y0 = (tile / tilesX) * kTileH;
+  int16_t w = (x0 + kTileW <= width) ? kTileW : width - x0;
+  int16_t h = (y0 + kTileH <= height) ? kTileH : height - y0;
+  uint16_t now[kTileW * kTileH];
+  uint16_t before[kTileW * kTileH];
+  int16_t n = 0;
+  bool changed = keyframe;
+  for (int16_t y = y0; y < y0 + h; ++y) {
+    const FramePixel *src = frame + y * width + x0;
+    uint16_t *prev = shadow + y * width + x0;
+    for (int16_t x = 0; x < w; ++x, ++n) {
+      now[n] = lut ? lut[src[x]] : static_cast<uint16_t>(src[x]);
+      before[n] = prev[x];
+      if (now[n] != prev[x]) changed = true;
+      prev[x] = now[n];
+    }
+  }
+  if (!changed) return false;
+
+  beginPacket(kTile);
+  putWord(tile);
+  int16_t i = 0;
+  while (i < n) {
+    int16_t run = 1;
+    if (!keyframe && now[i] == before[i]) {
+      while (i + run < n && run < kMaxRun && now[i + run] == before[i + run]) ++run;
+      putByte(kSkip | (run - 1));
+    } else if (i + 1 < n && now[i + 1] == now[i]) {
+      while (i + run < n && run < kMaxRun && now[i + run] == now[i]) ++run;
+      putByte(kFill | (run - 1));
+      putColor(now[i]);
+    } else {
+      // Up to where a skip or a repeat would be cheaper.
+      while (i + run < n && run < kMaxRun && (keyframe || now[i + run] != before[i + run]) &&
+             !(i + run + 1 < n && now[i + run + 1] == now[i + run])) {
+        ++run;
+      }
+      putByte(kLiteral | (run - 1));
+      for (int16_t k = 0; k < run; ++k) {
+        putColor(now[i + k]);
+      }
+    }
+    i += run;
+  }
+  endPacket();
+  counters.rawBytes += static_cast<uint32_t>(n) * 2;
+  return true;
+}
+
+void FrameMirror::beginPacket(uint8_t type) {
+  outLen = 0;
+  outPos = 0;
+  out[outLen++] = kSync0;
+  out[outLen++] = kSync1;
+  out[outLen++] = type;
+  // Length, filled in by endPacket().
+  outLen += 2;
+}
+
+void FrameMirror::putByte(uint8_t value) {
+  out[outLen++] = value;
+}
+
+void FrameMirror::putWord(uint16_t value) {
+  out[outLen++] = static_cast<uint8_t>(value);
+  out[outLen++] = static_cast<uint8_t>(value >> 8);
+}
+
+void FrameMirror::putColor(uint16_t color) {
+  // Framebuffers hold the panel's byte order, high byte first in memory.
+  memcpy(out + outLen, &color, sizeof(color));
+  outLen += sizeof(color);
+}
+
+void FrameMirror::endPacket() {
+  uint16_t len = outLen - 5;
+  out[3] = static_cast<uint8_t>(len);
+  out[4] = static_cast<uint8_t>(len >> 8);
+  uint8_t sum = 0;
+  for (uint16_t i = 2; i < outLen; ++i) {
+    sum += out[i];
+  }
+  out[outLen++] = sum;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "FlushPlanner.h"
+#include "Palette.h"
+
+// Streams the screen over the serial port for tools/mirror to rebuild.
+// Only what the panel was sent is looked at: flushed rects mark mirror
+// tiles pending, and service() encodes pending tiles against a copy of
+// what the receiver already has, writing no more than the port accepts
+// without blocking. Frames flushed faster than the port drains merge in
+// the pending set, so the stream drops intermediate frames, never tiles.
+//
+// Packets: A5 5A, type, payload length (u16 LE), payload, then the low
+// byte of the sum of type, length and payload bytes.
+//   'H' width u16, height u16, tile width u8, tile height u8. Starts a
+//       keyframe, whose tiles hold no skips; receivers join there.
+//   'T' tile index u16, then the tile's pixels in row order as tokens:
+//       00nnnnnn skip n+1 pixels, unchanged since the last frame
+//       01nnnnnn c  n+1 pixels of color c
+//       10nnnnnn c… n+1 literal colors
+//       Colors are RGB565, high byte first, as the panel receives them.
+//   'F' sequence u16, millis u32, frames flushed since the last F u16.
+//       Every tile before it is current: the receiver has a whole frame.
+class FrameMirror {
+public:
+  static const int16_t kTileW = 16;
+  static const int16_t kTileH = 8;
+  static const uint16_t kMaxTiles = 256;
+  // Resent in full this often, so a receiver that joins late or lost a
+  // packet recovers.
+  static const uint32_t kKeyframeMs = 10000;
+  // Serial TX buffer to ask for; the UART FIFO alone takes 128 bytes per
+  // loop pass.
+  static const size_t kTxBufferBytes = 2048;
+
+  struct Stats {
+    uint32_t framesFlushed;
+    uint32_t framesSent;
+    uint32_t tilesSent;
+    uint32_t rawBytes;     // tile pixels sent, at two bytes each
+    uint32_t streamBytes;  // bytes written, framing included
+  };
+
+  bool begin(int16_t width, int16_t height);
+  // A frame was queued to the panel with these rects.
+  void markFrame(const FlushRect *rects, uint16_t count);
+  // Pixels changed on the panel without a flush, e.g. hardware scroll.
+  void markRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  // frame is the buffer the panel mirrors; lut expands indexed pixels.
+  void service(const FramePixel *frame, const uint16_t *lut, uint32_t nowMs);
+
+  const Stats &stats() const { return counters; }
+
+private:
+  static const uint16_t kMaxPacket = 400;
+
+  void beginPacket(uint8_t type);
+  void putByte(uint8_t value);
+  void putWord(uint16_t value);
+  void putColor(uint16_t color);
+  void endPacket();
+  int16_t nextPending();
+  // False when the tile matches the receiver and needs no packet.
+  bool encodeTile(uint16_t tile, const FramePixel *frame, const uint16_t *lut);
+
+  int16_t width = 0;
+  int16_t height = 0;
+  int16_t tilesX = 0;
+  uint16_t tileCount = 0;
+  // What the receiver has, in panel-order RGB565.
+  uint16_t *shadow = nullptr;
+  uint8_t pending[kMaxTiles];
+  uint16_t cursor = 0;
+  bool keyframe = false;
+  bool keyframeDue = true;
+  uint32_t lastKeyframeMs = 0;
+  bool frameOpen = false;
+  uint16_t flushedSinceEnd = 0;
+  uint16_t sequence = 0;
+
+  uint8_t out[kMaxPacket];
+  uint16_t outLen = 0;
+  uint16_t outPos = 0;
+  Stats counters = {};
+};
@@ -0,0 +1,35 @@
+#include "FrameScheduler.h"
+
+void FrameScheduler::begin(uint8_t regionCount, uint32_t nowMs) {
+  count = (regionCount > kMaxRegions) ? kMaxRegions : regionCount;
+  for (uint8_t i = 0; i < count; ++i) {
+    deadlines[i] = nowMs;
+  }
+}
+
+void FrameScheduler::setInterval(uint8_t region, uint16_t intervalMs) {
+  if (region < count) intervals[region] = intervalMs;
+}
+
+uint8_t FrameScheduler::due(uint32_t nowMs) const {
+  uint8_t mask = 0;
+  for (uint8_t i = 0; i < count; ++i) {
+    if (static_cast<int32_t>(nowMs - deadlines[i]) >= 0) mask |= 1U << i;
+  }
+  return mask;
+}
+
+void FrameScheduler::advance(uint8_t dueMask, uint8_t drawnMask, uint32_t nowMs) {
+  for (uint8_t i = 0; i < count; ++i) {
+    uint8_t bit = 1U << i;
+    if (dueMask & bit) {
+      counters.due[i]++;
+      // Keep the cadence unless the loop fell a whole interval behind.
+      deadlines[i] += intervals[i];
+      if (static_cast<int32_t>(nowMs - deadlines[i]) >= 0) deadlines[i] = nowMs + intervals[i];
+    } else if (drawnMask & bit) {
+      deadlines[i] = nowMs + intervals[i];
+    }
+    if (drawnMask & bit) counters.drawn[i]++;
+  }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Gives every screen region its own refresh deadline. due() lists the
+// regions whose interval ran out; after the loop has drawn (or found idle)
+// what it could, advance() schedules the next deadlines. A region drawn
+// early, e.g. after a button press, starts a fresh interval.
+class FrameScheduler {
+public:
+  static const uint8_t kMaxRegions = 4;
+
+  struct Stats {
+    uint32_t due[kMaxRegions];
+    uint32_t drawn[kMaxRegions];
+  };
+
+  void begin(uint8_t regionCount, uint32_t nowMs);
+  void setInterval(uint8_t region, uint16_t intervalMs);
+  uint16_t interval(uint8_t region) const { return intervals[region]; }
+
+  uint8_t due(uint32_t nowMs) const;
+  void advance(uint8_t dueMask, uint8_t drawnMask, uint32_t nowMs);
+  // Running totals; they are never reset.
+  const Stats &stats() const { return counters; }
+
+private:
+  uint8_t count = 0;
+  uint16_t intervals[kMaxRegions] = {0};
+  uint32_t deadlines[kMaxRegions] = {0};
+  Stats counters = {};
+};
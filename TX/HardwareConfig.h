@@ -28,16 +28,23 @@
 // Outputs
 #define PIN_BUZZER 18 
 
-// TFT Display (ILI9163)
+// TFT Display
 #define PIN_TFT_MOSI 13
 #define PIN_TFT_SCLK 14
 #define PIN_TFT_CS    5
 #define PIN_TFT_DC   25
 #define PIN_TFT_RST   4
 
-// TFT Orientation (MADCTL)
-// 0x08 = portrait, 0xC8 = portrait flipped 180, 0x48 = mirror X, 0x88 = mirror Y
-#define TFT_MADCTL 0xC8
+// TFT Controller (see PanelDriver.h)
+#define PANEL_ST7735  1
+#define PANEL_ILI9163 2
+#define PANEL_ST7789  3
+#define PANEL_ILI9341 4
+#define TFT_PANEL PANEL_ILI9163
+
+// TFT Orientation (MADCTL MY/MX/MV bits; the panel adds its color order)
+// 0x00 = portrait, 0xC0 = portrait flipped 180, 0x40 = mirror X, 0x80 = mirror Y
+#define TFT_ORIENTATION 0xC0
 
 // Status LED
 #define PIN_LED_BUILTIN 2
@@ -45,6 +52,28 @@
 // --- System ---
 #define SERIAL_BAUD 115200
 
+// --- Display Pipeline ---
+#define PERF_BENCH 0      // Set to 1 to print renderer micro-benchmarks at boot
+#define FRAME_STATS 0     // Set to 1 to print flush statistics once per second
+#define FRAME_TILE_HASH 0 // 1 = single framebuffer + per-tile hashes instead of front/back diff
+#define FRAME_TILE_HASH_VERIFY 0 // 1 = keep a shadow copy to count hash collisions (debug only)
+#define FRAME_INDEXED 0   // 1 = 8bpp framebuffers holding ColorToken indices, expanded at flush
+#define FRAME_BAND_ROWS 0 // >0 = render in strips of this many rows instead of full framebuffers
+#define FRAME_DISPLAY_LIST 0 // 1 = record draw calls, diff with last frame, rasterize only changed areas
+#ifndef FRAME_TILE_W        // tools/flushsim sets these from the command line for its sweep
+#define FRAME_TILE_W 128  // dirty-tile size the flush diff and the planner work in; full-width tiles
+#define FRAME_TILE_H 8    // flush several rows per SPI transaction (chosen with tools/flushsim/sweep.sh)
+#endif
+#define UI_LAYER_CACHE_BYTES 0 // >0 = cache static list-screen layers in this much heap (~34KB per RGB565 layer)
+#define FRAME_HW_SCROLL 1 // 1 = scroll lists with the panel's vertical scroll (front/back diff modes only)
+#define FRAME_IDLE_SKIP 1 // 1 = skip frames when nothing the current screen reads has changed
+#define FRAME_IDLE_REFRESH_MS 1000 // redraw at least this often even when idle
+#define FRAME_OVERLAY_MS 16 // status bar / temperature strip refresh interval; screens set their own
+#define TEXT_CACHE_BYTES 3072 // arena for cached text-run spans; 0 = rasterize every glyph
+#define SESSION_RECORD 0  // 1 = print input changes over serial as a session tools/flushsim can replay
+#define FRAME_MIRROR 0    // 1 = stream flushed tiles over serial for tools/mirror (raise SERIAL_BAUD to 921600+)
+#define RENDER_OVERDRAW 0 // 1 = count renderer writes per pixel; print overdraw heatmaps and per-screen averages
+
 // --- Configuration ---
 #define TEST_MODE 0       // Set to 0 to use real inputs
 #define JOY_DEADZONE 250  // Increased Deadzone
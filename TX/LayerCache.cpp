@@ -0,0 +1,50 @@
+#include "LayerCache.h"
+
+#include <esp_heap_caps.h>
+
+void LayerCache::begin(size_t budgetBytes, int16_t width, int16_t rows) {
+  layerBytes = static_cast<size_t>(width) * rows * sizeof(FramePixel);
+  size_t fit = layerBytes ? budgetBytes / layerBytes : 0;
+  capacity = (fit > kMaxEntries) ? kMaxEntries : static_cast<uint8_t>(fit);
+}
+
+FramePixel *LayerCache::acquire(uint32_t key, bool &fresh) {
+  ++useClock;
+  Entry *victim = nullptr;
+  for (uint8_t i = 0; i < used; ++i) {
+    Entry &e = entries[i];
+    if (e.valid && e.key == key) {
+      e.lastUse = useClock;
+      counters.hits++;
+      fresh = false;
+      return e.pixels;
+    }
+    if (!victim || !e.valid || (victim->valid && e.lastUse < victim->lastUse)) {
+      victim = &e;
+    }
+  }
+
+  counters.misses++;
+  if (used < capacity) {
+    FramePixel *pixels = static_cast<FramePixel *>(heap_caps_malloc(layerBytes, MALLOC_CAP_8BIT));
+    if (pixels) {
+      victim = &entries[used++];
+      victim->pixels = pixels;
+      victim->valid = false;
+    }
+  }
+  if (!victim) return nullptr;
+  if (victim->valid) counters.evictions++;
+
+  victim->key = key;
+  victim->lastUse = useClock;
+  victim->valid = true;
+  fresh = true;
+  return victim->pixels;
+}
+
+void LayerCache::invalidate() {
+  for (uint8_t i = 0; i < used; ++i) {
+    entries[i].valid = false;
+  }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Palette.h"
+
+// Pre-rendered static layers (header, row frames, labels) of list screens.
+// Every layer covers the same band of screen rows; entries are allocated
+// on demand up to a byte budget and the least recently used one is reused
+// once the budget is spent.
+class LayerCache {
+public:
+  static const uint8_t kMaxEntries = 8;
+
+  struct Stats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+  };
+
+  void begin(size_t budgetBytes, int16_t width, int16_t rows);
+
+  // Returns the layer for key. fresh is set when the caller has to render
+  // it first. Returns nullptr if no memory could be had.
+  FramePixel *acquire(uint32_t key, bool &fresh);
+  void invalidate();
+
+  const Stats &stats() const { return counters; }
+  uint8_t entryCount() const { return used; }
+
+private:
+  struct Entry {
+    uint32_t key;
+    uint32_t lastUse;
+    FramePixel *pixels;
+    bool valid;
+  };
+
+  Entry entries[kMaxEntries] = {};
+  uint8_t used = 0;
+  uint8_t capacity = 0;
+  size_t layerBytes = 0;
+  uint32_t useClock = 0;
+  Stats counters;
+};
@@ -0,0 +1,70 @@
+#include "Overdraw.h"
+
+namespace {
+const char kHeatScale[] = " .:-=+*#%@";
+const uint8_t kHeatSteps = sizeof(kHeatScale) - 2;
+
+const char *const kKindNames[OVERDRAW_KIND_COUNT] = {"clear", "fill", "line", "text", "shape", "blit", "blend"};
+}  // namespace
+
+const char *OverdrawMap::kindName(OverdrawKind kind) {
+  return (kind < OVERDRAW_KIND_COUNT) ? kKindNames[kind] : "?";
+}
+
+bool OverdrawMap::begin(int16_t w, int16_t h) {
+  counts = static_cast<uint8_t *>(malloc(static_cast<size_t>(w) * h));
+  if (!counts) return false;
+  mapW = w;
+  mapH = h;
+  reset();
+  return true;
+}
+
+void OverdrawMap::reset() {
+  if (counts) memset(counts, 0, static_cast<size_t>(mapW) * mapH);
+  total = 0;
+  coveredPixels = 0;
+  memset(kindWrites, 0, sizeof(kindWrites));
+}
+
+void OverdrawMap::add(OverdrawKind kind, int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (!counts || w <= 0 || h <= 0) return;
+  uint32_t pixels = static_cast<uint32_t>(w) * h;
+  total += pixels;
+  kindWrites[kind] += pixels;
+  uint8_t *row = counts + static_cast<int32_t>(y) * mapW + x;
+  for (int16_t yy = 0; yy < h; ++yy, row += mapW) {
+    for (int16_t xx = 0; xx < w; ++xx) {
+      uint8_t &n = row[xx];
+      if (n == 0) coveredPixels++;
+      if (n < 0xFF) n++;
+    }
+  }
+}
+
+void OverdrawMap::printHeatmap() const {
+  if (!counts) return;
+  // Bars on both sides keep blank cells visible; wide enough for 320 px.
+  char line[80 + 3];
+  int16_t cols = mapW / kCellW;
+  if (cols > 80) cols = 80;
+  line[0] = '|';
+  for (int16_t cy = 0; cy < mapH; cy += kCellH) {
+    int16_t cellH = (cy + kCellH > mapH) ? mapH - cy : kCellH;
+    for (int16_t cx = 0; cx < cols; ++cx) {
+      uint32_t sum = 0;
+      for (int16_t y = cy; y < cy + cellH; ++y) {
+        const uint8_t *row = counts + static_cast<int32_t>(y) * mapW + cx * kCellW;
+        for (int16_t x = 0; x < kCellW; ++x) {
+          sum += row[x];
+        }
+      }
+      uint32_t cell = kCellW * cellH;
+      uint32_t mean = (sum + cell / 2) / cell;
+      line[1 + cx] = kHeatScale[mean > kHeatSteps ? kHeatSteps : mean];
+    }
+    line[1 + cols] = '|';
+    line[2 + cols] = '\0';
+    Serial.println(line);
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Primitive families the renderer's pixel writes are counted under.
+enum OverdrawKind : uint8_t {
+  OVERDRAW_CLEAR = 0,
+  OVERDRAW_FILL,
+  OVERDRAW_LINE,
+  OVERDRAW_TEXT,
+  OVERDRAW_SHAPE,  // circles, arcs, round rects, triangles, thick lines
+  OVERDRAW_BLIT,
+  OVERDRAW_BLEND,
+  OVERDRAW_KIND_COUNT
+};
+
+// Debug counters behind RENDER_OVERDRAW: how many times each screen pixel
+// was written since reset(), and how many writes each primitive family
+// made. Pixels written more than once were drawn over by a later primitive
+// in the same frame; the heatmap shows where that happens.
+class OverdrawMap {
+public:
+  static const int16_t kCellW = 4;
+  static const int16_t kCellH = 8;
+
+  static const char *kindName(OverdrawKind kind);
+
+  bool begin(int16_t width, int16_t height);
+  void reset();
+  // Renderer calls this with the clipped rect a primitive wrote.
+  void add(OverdrawKind kind, int16_t x, int16_t y, int16_t w, int16_t h);
+
+  // Writes to the pixel since reset(), saturating at 255.
+  uint8_t at(int16_t x, int16_t y) const { return counts[static_cast<int32_t>(y) * mapW + x]; }
+  uint32_t writes() const { return total; }
+  uint32_t writes(OverdrawKind kind) const { return kindWrites[kind]; }
+  // Pixels written at least once.
+  uint32_t covered() const { return coveredPixels; }
+  int16_t width() const { return mapW; }
+  int16_t height() const { return mapH; }
+
+  // Prints one character per kCellW x kCellH cell for its mean write
+  // count: ' ' none, '.' one, then ":-=+*#%" up to '@' for nine or more.
+  void printHeatmap() const;
+
+private:
+  uint8_t *counts = nullptr;
+  int16_t mapW = 0;
+  int16_t mapH = 0;
+  uint32_t total = 0;
+  uint32_t coveredPixels = 0;
+  uint32_t kindWrites[OVERDRAW_KIND_COUNT] = {};
+};
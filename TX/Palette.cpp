@@ -64,6 +64,10 @@ uint16_t hsvTo565(const HsvSpec &spec) {
 uint16_t gray565(uint8_t v) {
   return rgbTo565(v, v, v);
 }
+
+uint16_t toPanelOrder(uint16_t v) {
+  return static_cast<uint16_t>((v << 8) | (v >> 8));
+}
 }  // namespace
 
 void Palette::begin() {
@@ -93,6 +97,13 @@ void Palette::begin() {
   colors[BAR_NEUTRAL] = colors[TEXT_MUTED];
 
   colors[GRID_LINE] = gray565(24);
+
+  // The panel takes RGB565 high byte first. Storing colors pre-swapped lets
+  // PanelIO DMA straight out of the framebuffer.
+  for (uint8_t i = 0; i < COLOR_TOKEN_COUNT; ++i) {
+    colors[i] = toPanelOrder(colors[i]);
+  }
+  rev++;
 }
 
 uint16_t Palette::color(ColorToken token) const {
@@ -101,3 +112,11 @@ uint16_t Palette::color(ColorToken token) const {
   }
   return colors[token];
 }
+
+FramePixel Palette::pixel(ColorToken token) const {
+#if FRAME_INDEXED
+  return token < COLOR_TOKEN_COUNT ? token : BG_PRIMARY;
+#else
+  return color(token);
+#endif
+}
@@ -2,6 +2,8 @@
 
 #include <Arduino.h>
 
+#include "HardwareConfig.h"
+
 enum ColorToken : uint8_t {
   BG_PRIMARY = 0,
   BG_PANEL,
@@ -26,11 +28,24 @@ enum ColorToken : uint8_t {
   COLOR_TOKEN_COUNT
 };
 
+// What the framebuffers store: panel-order RGB565, or the ColorToken itself
+// when FRAME_INDEXED defers the palette lookup to the flush.
+#if FRAME_INDEXED
+typedef uint8_t FramePixel;
+#else
+typedef uint16_t FramePixel;
+#endif
+
 class Palette {
 public:
   void begin();
+  // Returns RGB565 in panel byte order (high byte first in memory).
   uint16_t color(ColorToken token) const;
+  FramePixel pixel(ColorToken token) const;
+  const uint16_t *table() const { return colors; }
+  uint16_t revision() const { return rev; }
 
 private:
   uint16_t colors[COLOR_TOKEN_COUNT];
+  uint16_t rev = 0;
 };
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "HardwareConfig.h"
+
+// Compile-time descriptions of the panel controllers the transmitter is
+// built for. TFT_PANEL picks one; PanelIO talks to it through
+// PanelDriver<>, so geometry, clock and init sequence are constants and
+// the flush path carries no per-panel branches.
+//
+// Init tables hold {command, argument count, arguments..., delay ms}
+// entries and end at kInitEnd. Offsets place the visible glass inside the
+// controller's memory; kMemoryRows is what the scroll definition counts.
+//
+// Limits: the offsets are 0 for the modules these entries were written
+// for. Breakouts that mount the glass shifted in controller memory (some
+// ST7735 tabs, 240x240 ST7789 glass) need their own entry with real
+// offsets. The frame size is a template parameter, but the UI is laid out
+// for 128x160 only, so every panel shows that frame.
+
+static const uint8_t kInitEnd = 0xFF;
+
+// MADCTL color order bit; orientation comes from TFT_ORIENTATION.
+static const uint8_t kMadctlBgr = 0x08;
+
+struct PanelST7735 {
+  static const int16_t kWidth = 128;
+  static const int16_t kHeight = 160;
+  static const int16_t kColOffset = 0;
+  static const int16_t kRowOffset = 0;
+  static const int16_t kMemoryRows = 160;
+  static const uint32_t kMaxSpiHz = 27000000;
+  static const uint8_t kColorOrder = kMadctlBgr;
+  static const uint8_t *init() {
+    static const uint8_t kTable[] = {
+      0x01, 0, 150,                   // SWRESET
+      0x11, 0, 255,                   // SLPOUT
+      0xB1, 3, 0x01, 0x2C, 0x2D, 0,   // FRMCTR1: normal mode frame rate
+      0x3A, 1, 0x05, 0,               // COLMOD: 16 bit
+      0x13, 0, 10,                    // NORON
+      0x29, 0, 100,                   // DISPON
+      kInitEnd
+    };
+    return kTable;
+  }
+};
+
+struct PanelILI9163 {
+  static const int16_t kWidth = 128;
+  static const int16_t kHeight = 160;
+  static const int16_t kColOffset = 0;
+  static const int16_t kRowOffset = 0;
+  static const int16_t kMemoryRows = 160;
+  // The shipped transmitter's panel, kept at the clock it was built with.
+  static const uint32_t kMaxSpiHz = 26000000;
+  static const uint8_t kColorOrder = kMadctlBgr;
+  static const uint8_t *init() {
+    static const uint8_t kTable[] = {
+      0x01, 0, 5,                     // SWRESET
+      0x11, 0, 120,                   // SLPOUT
+      0x3A, 1, 0x05, 0,               // COLMOD: 16 bit
+      0x29, 0, 20,                    // DISPON
+      kInitEnd
+    };
+    return kTable;
+  }
+};
+
+struct PanelST7789 {
+  static const int16_t kWidth = 240;
+  static const int16_t kHeight = 320;
+  static const int16_t kColOffset = 0;
+  static const int16_t kRowOffset = 0;
+  static const int16_t kMemoryRows = 320;
+  static const uint32_t kMaxSpiHz = 80000000;
+  static const uint8_t kColorOrder = 0;
+  static const uint8_t *init() {
+    static const uint8_t kTable[] = {
+      0x01, 0, 150,                   // SWRESET
+      0x11, 0, 120,                   // SLPOUT
+      0x3A, 1, 0x55, 10,              // COLMOD: 16 bit
+      0x21, 0, 10,                    // INVON: IPS glass is inverted
+      0x13, 0, 10,                    // NORON
+      0x29, 0, 20,                    // DISPON
+      kInitEnd
+    };
+    return kTable;
+  }
+};
+
+struct PanelILI9341 {
+  static const int16_t kWidth = 240;
+  static const int16_t kHeight = 320;
+  static const int16_t kColOffset = 0;
+  static const int16_t kRowOffset = 0;
+  static const int16_t kMemoryRows = 320;
+  static const uint32_t kMaxSpiHz = 40000000;
+  static const uint8_t kColorOrder = kMadctlBgr;
+  static const uint8_t *init() {
+    static const uint8_t kTable[] = {
+      0x01, 0, 150,                   // SWRESET
+      0xC0, 1, 0x23, 0,               // PWCTR1: GVDD 4.6 V
+      0xC1, 1, 0x10, 0,               // PWCTR2
+      0xC5, 2, 0x3E, 0x28, 0,         // VMCTR1
+      0xC7, 1, 0x86, 0,               // VMCTR2
+      0x3A, 1, 0x55, 0,               // COLMOD: 16 bit
+      0xB1, 2, 0x00, 0x18, 0,         // FRMCTR1: 79 Hz
+      0x11, 0, 120,                   // SLPOUT
+      0x29, 0, 20,                    // DISPON
+      kInitEnd
+    };
+    return kTable;
+  }
+};
+
+#if TFT_PANEL == PANEL_ST7735
+typedef PanelST7735 PanelModel;
+#elif TFT_PANEL == PANEL_ILI9163
+typedef PanelILI9163 PanelModel;
+#elif TFT_PANEL == PANEL_ST7789
+typedef PanelST7789 PanelModel;
+#elif TFT_PANEL == PANEL_ILI9341
+typedef PanelILI9341 PanelModel;
+#else
+#error "TFT_PANEL must name one of the PANEL_* controllers"
+#endif
+
+// What PanelIO derives from a panel for a FrameW x FrameH frame. The frame
+// is centered on glass larger than itself; kBorder says the rest of the
+// glass has to be cleared once. The SPI clock is the controller's limit,
+// capped at what the bus reaches: 80 MHz on the HSPI IO_MUX pins, 40 MHz
+// through the GPIO matrix.
+template <class Panel, int16_t FrameW, int16_t FrameH>
+struct PanelDriver {
+  static_assert(Panel::kWidth >= FrameW && Panel::kHeight >= FrameH, "panel smaller than the frame");
+
+  static const int16_t kOriginX = Panel::kColOffset + (Panel::kWidth - FrameW) / 2;
+  static const int16_t kOriginY = Panel::kRowOffset + (Panel::kHeight - FrameH) / 2;
+  static const bool kBorder = Panel::kWidth > FrameW || Panel::kHeight > FrameH;
+  static const uint32_t kBusMaxHz = (PIN_TFT_MOSI == 13 && PIN_TFT_SCLK == 14) ? 80000000 : 40000000;
+  static const uint32_t kSpiClockHz = (Panel::kMaxSpiHz < kBusMaxHz) ? Panel::kMaxSpiHz : kBusMaxHz;
+  static const uint8_t kMadctl = TFT_ORIENTATION | Panel::kColorOrder;
+  // With MY set, physical lines run bottom-up relative to the frame.
+  static const bool kMirrored = (TFT_ORIENTATION & 0x80) != 0;
+};
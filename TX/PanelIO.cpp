@@ -3,51 +3,165 @@
 #include <driver/gpio.h>
 #include <esp_heap_caps.h>
 
+#include "PanelDriver.h"
+
 namespace {
-static const int kSpiClockHz = 26000000;
+typedef PanelDriver<PanelModel, PanelIO::kWidth, PanelIO::kHeight> Driver;
+
+// Transaction descriptors; an address window takes five of them.
+static const int kQueueDepth = 8;
+static const int kWindowTrans = 5;
+static const int16_t kChunkRows = 16;
+static_assert(FRAME_INDEXED || FlushPlanner::kChunkRows == kChunkRows, "the planner charges full-width rects by chunk");
+
+// Transaction user values: the level DC needs while it is on the wire.
+void *const kDcCommand = reinterpret_cast<void *>(0);
+void *const kDcData = reinterpret_cast<void *>(1);
 
 spi_device_handle_t spi;
-uint16_t *dmaLineBuffers[2];
+spi_transaction_t trans[kQueueDepth];
+#if FRAME_INDEXED
+uint16_t *dmaLineBuffers[kQueueDepth];
+#endif
+
+// One frame's worth of rects being streamed out. Every byte goes through
+// the queue, window commands included: each transaction carries its DC
+// level and the pre-transfer callback sets the pin, so the next rect's
+// address window queues right behind the previous rect's pixels.
+struct FlushJob {
+  const FlushRect *rects;
+  uint16_t count;
+  uint16_t rectIndex;
+  int16_t row;
+  int16_t runEnd;
+  bool windowSet;
+  const uint16_t *pixels;
+  const uint8_t *indexed;
+  const uint16_t *lut;
+  int16_t stride;
+  int16_t originY;
+  int inFlight;
+  int slot;
+  bool active;
+};
 
-uint16_t swap565(uint16_t v) {
-  return static_cast<uint16_t>((v << 8) | (v >> 8));
+FlushJob job = {};
+FlushRect singleRect;
+
+int16_t scrollTop = 0;
+int16_t scrollRows = 0;
+int16_t scrollOffset = 0;
+
+void IRAM_ATTR setDcPreTransfer(spi_transaction_t *t) {
+  gpio_set_level(static_cast<gpio_num_t>(PIN_TFT_DC), t->user == kDcData ? 1 : 0);
 }
 
+// Fills a transaction; up to four bytes travel inside it.
+void prepare(spi_transaction_t &t, void *dc, const uint8_t *data, size_t len) {
+  memset(&t, 0, sizeof(t));
+  t.length = len * 8;
+  t.user = dc;
+  if (len <= sizeof(t.tx_data)) {
+    t.flags = SPI_TRANS_USE_TXDATA;
+    memcpy(t.tx_data, data, len);
+  } else {
+    t.tx_buffer = data;
+  }
+}
+
+// Outside a flush, commands are short enough that polling beats the
+// interrupt round trip of a queued transaction.
 void writeCommand(uint8_t cmd) {
-  spi_transaction_t t = {};
-  t.length = 8;
-  t.tx_buffer = &cmd;
-  digitalWrite(PIN_TFT_DC, LOW);
-  spi_device_transmit(spi, &t);
+  spi_transaction_t t;
+  prepare(t, kDcCommand, &cmd, 1);
+  spi_device_polling_transmit(spi, &t);
 }
 
 void writeData(const uint8_t *data, size_t len) {
   if (!data || len == 0) return;
-  spi_transaction_t t = {};
-  t.length = len * 8;
-  t.tx_buffer = data;
-  digitalWrite(PIN_TFT_DC, HIGH);
-  spi_device_transmit(spi, &t);
+  spi_transaction_t t;
+  prepare(t, kDcData, data, len);
+  spi_device_polling_transmit(spi, &t);
 }
 
-void setAddrWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
-  uint8_t data[4];
+// Descriptors are reaped in queue order, so the one at job.slot is free
+// whenever fewer than kQueueDepth are in flight.
+spi_transaction_t *nextTrans() {
+  return &trans[job.slot];
+}
 
-  writeCommand(0x2A);
-  data[0] = static_cast<uint8_t>(x0 >> 8);
-  data[1] = static_cast<uint8_t>(x0 & 0xFF);
-  data[2] = static_cast<uint8_t>(x1 >> 8);
-  data[3] = static_cast<uint8_t>(x1 & 0xFF);
-  writeData(data, 4);
+void submit(spi_transaction_t *t) {
+  spi_device_queue_trans(spi, t, portMAX_DELAY);
+  job.inFlight++;
+  job.slot = (job.slot + 1) % kQueueDepth;
+}
 
-  writeCommand(0x2B);
-  data[0] = static_cast<uint8_t>(y0 >> 8);
-  data[1] = static_cast<uint8_t>(y0 & 0xFF);
-  data[2] = static_cast<uint8_t>(y1 >> 8);
-  data[3] = static_cast<uint8_t>(y1 & 0xFF);
-  writeData(data, 4);
+void queueBytes(void *dc, const uint8_t *data, size_t len) {
+  spi_transaction_t *t = nextTrans();
+  prepare(*t, dc, data, len);
+  submit(t);
+}
 
-  writeCommand(0x2C);
+// CASET/RASET argument: first and last address, big endian.
+void encodeRange(uint8_t *out, int16_t first, int16_t last) {
+  out[0] = static_cast<uint8_t>(first >> 8);
+  out[1] = static_cast<uint8_t>(first & 0xFF);
+  out[2] = static_cast<uint8_t>(last >> 8);
+  out[3] = static_cast<uint8_t>(last & 0xFF);
+}
+
+// CASET, RASET and RAMWR with their arguments for a window in frame
+// coordinates; needs kWindowTrans free descriptors.
+void queueWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  static const uint8_t kCaset = 0x2A;
+  static const uint8_t kRaset = 0x2B;
+  static const uint8_t kRamwr = 0x2C;
+  uint8_t cols[4];
+  uint8_t rows[4];
+  encodeRange(cols, x0 + Driver::kOriginX, x1 + Driver::kOriginX);
+  encodeRange(rows, y0 + Driver::kOriginY, y1 + Driver::kOriginY);
+  queueBytes(kDcCommand, &kCaset, 1);
+  queueBytes(kDcData, cols, sizeof(cols));
+  queueBytes(kDcCommand, &kRaset, 1);
+  queueBytes(kDcData, rows, sizeof(rows));
+  queueBytes(kDcCommand, &kRamwr, 1);
+}
+
+// Panel memory row holding screen row y under the current scroll offset.
+int16_t memoryRow(int16_t y) {
+  if (scrollRows == 0 || y < scrollTop || y >= scrollTop + scrollRows) return y;
+  return scrollTop + (y - scrollTop + scrollOffset) % scrollRows;
+}
+
+// How many of the next rows from screen row y are contiguous in panel
+// memory, i.e. before the scroll area starts, ends or wraps.
+int16_t contiguousRows(int16_t y, int16_t rows) {
+  int16_t run = rows;
+  if (scrollOffset == 0 || y >= scrollTop + scrollRows) return run;
+  if (y < scrollTop) {
+    run = scrollTop - y;
+  } else {
+    int16_t toWrap = scrollTop + scrollRows - memoryRow(y);
+    int16_t toEnd = scrollTop + scrollRows - y;
+    run = (toWrap < toEnd) ? toWrap : toEnd;
+  }
+  return (run < rows) ? run : rows;
+}
+
+// VSCRDEF and VSCRSADD count physical lines of controller memory, which
+// run bottom-up in screen terms when MADCTL mirrors Y. Returns the first
+// physical line of frame rows [top, top + rows).
+int16_t physicalTop(int16_t top, int16_t rows) {
+  int16_t y = Driver::kOriginY + top;
+  return Driver::kMirrored ? PanelModel::kMemoryRows - y - rows : y;
+}
+
+void writeScroll() {
+  int16_t fixedTop = physicalTop(scrollTop, scrollRows);
+  int16_t start = fixedTop + (Driver::kMirrored ? (scrollRows - scrollOffset) % scrollRows : scrollOffset);
+  uint8_t data[2] = {static_cast<uint8_t>(start >> 8), static_cast<uint8_t>(start & 0xFF)};
+  writeCommand(0x37);
+  writeData(data, 2);
 }
 
 void resetPanel() {
@@ -58,21 +172,132 @@ void resetPanel() {
 }
 
 void initPanel() {
-  writeCommand(0x01);
-  delay(5);
-  writeCommand(0x11);
-  delay(120);
+  for (const uint8_t *p = PanelModel::init(); *p != kInitEnd;) {
+    uint8_t cmd = *p++;
+    uint8_t count = *p++;
+    writeCommand(cmd);
+    writeData(p, count);
+    p += count;
+    if (*p) delay(*p);
+    ++p;
+  }
+  uint8_t madctl = Driver::kMadctl;
+  writeCommand(0x36);
+  writeData(&madctl, 1);
+}
 
-  uint8_t data = 0x05;
-  writeCommand(0x3A);
-  writeData(&data, 1);
+// Blanks the glass around a frame smaller than the panel; flushes only
+// ever write inside the frame.
+void clearBorder() {
+  size_t rowBytes = PanelModel::kWidth * sizeof(uint16_t);
+  uint8_t *zeros = static_cast<uint8_t *>(heap_caps_malloc(rowBytes, MALLOC_CAP_DMA));
+  if (!zeros) return;
+  memset(zeros, 0, rowBytes);
+  uint8_t range[4];
+  encodeRange(range, PanelModel::kColOffset, PanelModel::kColOffset + PanelModel::kWidth - 1);
+  writeCommand(0x2A);
+  writeData(range, sizeof(range));
+  encodeRange(range, PanelModel::kRowOffset, PanelModel::kRowOffset + PanelModel::kHeight - 1);
+  writeCommand(0x2B);
+  writeData(range, sizeof(range));
+  writeCommand(0x2C);
+  for (int16_t y = 0; y < PanelModel::kHeight; ++y) {
+    writeData(zeros, rowBytes);
+  }
+  heap_caps_free(zeros);
+}
 
-  data = TFT_MADCTL;
-  writeCommand(0x36);
-  writeData(&data, 1);
+void reapTransactions() {
+  spi_transaction_t *ret;
+  while (job.inFlight > 0 && spi_device_get_trans_result(spi, &ret, 0) == ESP_OK) {
+    job.inFlight--;
+  }
+}
+
+bool rectValid(const FlushRect &r) {
+  if (r.w <= 0 || r.h <= 0) return false;
+  if (r.x < 0 || r.y < 0) return false;
+  return r.x + r.w <= PanelIO::kWidth && r.y + r.h <= PanelIO::kHeight;
+}
+
+// Queues the next chunk of the current rect into a free slot. Full-width
+// RGB565 rects are contiguous in the framebuffer and go out in multi-row
+// chunks straight from it; narrower rects send one row each. Indexed rows
+// are expanded into the slot's line buffer first, which is only reused
+// after its previous transaction has been reaped.
+void queueChunk(const FlushRect &r) {
+  int16_t rows = 1;
+  spi_transaction_t *t = nextTrans();
+  memset(t, 0, sizeof(*t));
+  t->user = kDcData;
+
+  if (job.pixels) {
+    if (r.w == job.stride) {
+      rows = (job.runEnd - job.row < kChunkRows) ? (job.runEnd - job.row) : kChunkRows;
+    }
+    t->tx_buffer = job.pixels + (r.y - job.originY + job.row) * job.stride + r.x;
+  } else {
+#if FRAME_INDEXED
+    const uint8_t *src = job.indexed + (r.y - job.originY + job.row) * job.stride + r.x;
+    uint16_t *line = dmaLineBuffers[job.slot];
+    for (int16_t xx = 0; xx < r.w; ++xx) {
+      line[xx] = job.lut[src[xx]];
+    }
+    t->tx_buffer = line;
+#endif
+  }
+  t->length = static_cast<size_t>(r.w) * rows * 16;
+  submit(t);
+  job.row += rows;
+}
+
+void serviceJob() {
+  if (!job.active) return;
+  reapTransactions();
+
+  while (job.rectIndex < job.count) {
+    const FlushRect &r = job.rects[job.rectIndex];
+    if (!rectValid(r)) {
+      job.rectIndex++;
+      continue;
+    }
+    // Rows that wrap in a scrolled area go out as separate windows.
+    if (!job.windowSet) {
+      if (job.inFlight > kQueueDepth - kWindowTrans) return;
+      int16_t y = r.y + job.row;
+      int16_t rows = contiguousRows(y, r.h - job.row);
+      int16_t my = memoryRow(y);
+      queueWindow(r.x, my, r.x + r.w - 1, my + rows - 1);
+      job.windowSet = true;
+      job.runEnd = job.row + rows;
+    }
+    while (job.row < job.runEnd && job.inFlight < kQueueDepth) {
+      queueChunk(r);
+    }
+    if (job.row < job.runEnd) return;
+    job.windowSet = false;
+    if (job.row < r.h) continue;
+    job.rectIndex++;
+    job.row = 0;
+  }
+
+  if (job.inFlight == 0) {
+    job.active = false;
+  }
+}
 
-  writeCommand(0x29);
-  delay(20);
+void startJob(const FlushRect *rects, uint16_t count, int16_t stride, int16_t originY) {
+  job.rects = rects;
+  job.count = count;
+  job.rectIndex = 0;
+  job.row = 0;
+  job.windowSet = false;
+  job.stride = stride;
+  job.originY = originY;
+  job.inFlight = 0;
+  job.slot = 0;
+  job.active = count > 0;
+  serviceJob();
 }
 }  // namespace
 
@@ -91,13 +316,14 @@ bool begin() {
   buscfg.sclk_io_num = PIN_TFT_SCLK;
   buscfg.quadwp_io_num = -1;
   buscfg.quadhd_io_num = -1;
-  buscfg.max_transfer_sz = kWidth * 2 * 16;
+  buscfg.max_transfer_sz = kWidth * 2 * kChunkRows;
 
   spi_device_interface_config_t devcfg = {};
-  devcfg.clock_speed_hz = kSpiClockHz;
+  devcfg.clock_speed_hz = Driver::kSpiClockHz;
   devcfg.mode = 0;
   devcfg.spics_io_num = PIN_TFT_CS;
-  devcfg.queue_size = 4;
+  devcfg.queue_size = kQueueDepth;
+  devcfg.pre_cb = setDcPreTransfer;
 
   esp_err_t err = spi_bus_initialize(HSPI_HOST, &buscfg, SPI_DMA_CH_AUTO);
   if (err != ESP_OK) {
@@ -108,51 +334,209 @@ bool begin() {
     return false;
   }
 
-  dmaLineBuffers[0] = static_cast<uint16_t *>(heap_caps_malloc(kWidth * sizeof(uint16_t), MALLOC_CAP_DMA));
-  dmaLineBuffers[1] = static_cast<uint16_t *>(heap_caps_malloc(kWidth * sizeof(uint16_t), MALLOC_CAP_DMA));
-  if (!dmaLineBuffers[0] || !dmaLineBuffers[1]) {
-    return false;
+#if FRAME_INDEXED
+  for (int i = 0; i < kQueueDepth; ++i) {
+    dmaLineBuffers[i] = static_cast<uint16_t *>(heap_caps_malloc(kWidth * sizeof(uint16_t), MALLOC_CAP_DMA));
+    if (!dmaLineBuffers[i]) {
+      return false;
+    }
   }
+#endif
 
   initPanel();
+  if (Driver::kBorder) clearBorder();
   return true;
 }
 
-void pushRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *buffer, int16_t stride) {
-  if (!buffer || w <= 0 || h <= 0) return;
-  if (x < 0 || y < 0) return;
-  if (x + w > kWidth || y + h > kHeight) return;
+bool beginFlush(const FlushRect *rects, uint16_t count, const uint16_t *buffer, int16_t stride, int16_t originY) {
+  if (job.active || !rects || !buffer) return false;
+  job.pixels = buffer;
+  job.indexed = nullptr;
+  job.lut = nullptr;
+  startJob(rects, count, stride, originY);
+  return true;
+}
 
-  setAddrWindow(x, y, x + w - 1, y + h - 1);
-  digitalWrite(PIN_TFT_DC, HIGH);
+bool beginFlush(const FlushRect *rects, uint16_t count, const uint8_t *buffer, int16_t stride, const uint16_t *lut,
+                int16_t originY) {
+#if FRAME_INDEXED
+  if (job.active || !rects || !buffer || !lut) return false;
+  job.pixels = nullptr;
+  job.indexed = buffer;
+  job.lut = lut;
+  startJob(rects, count, stride, originY);
+  return true;
+#else
+  (void)rects; (void)count; (void)buffer; (void)stride; (void)lut; (void)originY;
+  return false;
+#endif
+}
 
-  spi_transaction_t trans[2];
-  memset(&trans, 0, sizeof(trans));
-  int bufIndex = 0;
-  const uint16_t *row = buffer + (y * stride) + x;
+bool flushBusy() {
+  serviceJob();
+  return job.active;
+}
 
-  for (int16_t yy = 0; yy < h; ++yy) {
-    uint16_t *dmaBuf = dmaLineBuffers[bufIndex];
-    for (int16_t xx = 0; xx < w; ++xx) {
-      dmaBuf[xx] = swap565(row[xx]);
+void waitFlush() {
+  while (job.active) {
+    if (job.inFlight > 0) {
+      spi_transaction_t *ret;
+      spi_device_get_trans_result(spi, &ret, portMAX_DELAY);
+      job.inFlight--;
     }
+    serviceJob();
+  }
+}
+
+void setScrollArea(int16_t top, int16_t rows) {
+  waitFlush();
+  if (top < 0 || rows <= 0 || top + rows > kHeight) {
+    top = 0;
+    rows = kHeight;
+  }
+  scrollTop = top;
+  scrollRows = rows;
+  scrollOffset = 0;
+
+  int16_t fixedTop = physicalTop(top, rows);
+  int16_t fixedBottom = PanelModel::kMemoryRows - fixedTop - rows;
+  uint8_t data[6] = {
+    static_cast<uint8_t>(fixedTop >> 8), static_cast<uint8_t>(fixedTop & 0xFF),
+    static_cast<uint8_t>(rows >> 8), static_cast<uint8_t>(rows & 0xFF),
+    static_cast<uint8_t>(fixedBottom >> 8), static_cast<uint8_t>(fixedBottom & 0xFF)
+  };
+  writeCommand(0x33);
+  writeData(data, 6);
+  writeScroll();
+}
+
+void scrollTo(int16_t offset) {
+  if (scrollRows == 0) return;
+  waitFlush();
+  offset %= scrollRows;
+  if (offset < 0) offset += scrollRows;
+  scrollOffset = offset;
+  writeScroll();
+}
+
+void pushRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *buffer, int16_t stride) {
+  waitFlush();
+  singleRect = {x, y, w, h};
+  if (beginFlush(&singleRect, 1, buffer, stride)) {
+    waitFlush();
+  }
+}
+
+void pushRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *buffer, int16_t stride, const uint16_t *lut) {
+  waitFlush();
+  singleRect = {x, y, w, h};
+  if (beginFlush(&singleRect, 1, buffer, stride, lut)) {
+    waitFlush();
+  }
+}
+}  // namespace PanelIO
+
+#if PERF_BENCH
+namespace {
+static const uint16_t kBenchIterations = 16;
+static const int16_t kBenchTile = 16;
+static const int16_t kBenchTiles = PanelIO::kWidth / kBenchTile;
 
-    spi_transaction_t *t = &trans[bufIndex];
-    t->length = w * 16;
-    t->tx_buffer = dmaBuf;
+// Reference for the former rect setup: DC driven with digitalWrite and a
+// blocking transaction per command and argument.
+void blockingWrite(void *dc, const uint8_t *data, size_t len) {
+  spi_transaction_t t;
+  prepare(t, dc, data, len);
+  digitalWrite(PIN_TFT_DC, (dc == kDcData) ? HIGH : LOW);
+  spi_device_transmit(spi, &t);
+}
 
+void blockingWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  uint8_t cmd = 0x2A;
+  uint8_t data[4];
+  encodeRange(data, x0 + Driver::kOriginX, x1 + Driver::kOriginX);
+  blockingWrite(kDcCommand, &cmd, 1);
+  blockingWrite(kDcData, data, sizeof(data));
+  cmd = 0x2B;
+  encodeRange(data, y0 + Driver::kOriginY, y1 + Driver::kOriginY);
+  blockingWrite(kDcCommand, &cmd, 1);
+  blockingWrite(kDcData, data, sizeof(data));
+  cmd = 0x2C;
+  blockingWrite(kDcCommand, &cmd, 1);
+  digitalWrite(PIN_TFT_DC, HIGH);
+}
+
+// The former flush of one rect: blocking window, queued rows, and a full
+// drain before the next window could go out.
+void blockingTile(const uint16_t *pixels, int16_t x) {
+  blockingWindow(x, 0, x + kBenchTile - 1, kBenchTile - 1);
+  int inFlight = 0;
+  spi_transaction_t *ret;
+  for (int16_t row = 0; row < kBenchTile; ++row) {
+    if (inFlight == kQueueDepth) {
+      spi_device_get_trans_result(spi, &ret, portMAX_DELAY);
+      inFlight--;
+    }
+    spi_transaction_t *t = &trans[row % kQueueDepth];
+    memset(t, 0, sizeof(*t));
+    t->user = kDcData;
+    t->tx_buffer = pixels + row * PanelIO::kWidth + x;
+    t->length = kBenchTile * 16;
     spi_device_queue_trans(spi, t, portMAX_DELAY);
+    inFlight++;
+  }
+  while (inFlight-- > 0) {
+    spi_device_get_trans_result(spi, &ret, portMAX_DELAY);
+  }
+}
+
+void benchReport(const char *name, uint32_t before, uint32_t after) {
+  Serial.printf("bench %-10s blocking %7lu cyc  queued %7lu cyc  (%lu%%)\n",
+    name,
+    static_cast<unsigned long>(before / kBenchIterations),
+    static_cast<unsigned long>(after / kBenchIterations),
+    static_cast<unsigned long>(before ? (after * 100ULL) / before : 0));
+}
+}  // namespace
+
+namespace PanelIO {
+void benchRectSetup() {
+  static uint16_t pixels[kWidth * kBenchTile];
+  static FlushRect rects[kBenchTiles];
+  for (int16_t i = 0; i < kBenchTiles; ++i) {
+    rects[i] = {static_cast<int16_t>(i * kBenchTile), 0, kBenchTile, kBenchTile};
+  }
+  waitFlush();
 
-    if (yy > 0) {
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kBenchIterations; ++i) {
+    blockingWindow(0, 0, kWidth - 1, 0);
+  }
+  uint32_t before = ESP.getCycleCount() - start;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kBenchIterations; ++i) {
+    queueWindow(0, 0, kWidth - 1, 0);
+    while (job.inFlight > 0) {
       spi_transaction_t *ret;
       spi_device_get_trans_result(spi, &ret, portMAX_DELAY);
+      job.inFlight--;
     }
-
-    bufIndex ^= 1;
-    row += stride;
   }
+  benchReport("window", before, ESP.getCycleCount() - start);
 
-  spi_transaction_t *ret;
-  spi_device_get_trans_result(spi, &ret, portMAX_DELAY);
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kBenchIterations; ++i) {
+    for (int16_t t = 0; t < kBenchTiles; ++t) {
+      blockingTile(pixels, t * kBenchTile);
+    }
+  }
+  before = ESP.getCycleCount() - start;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kBenchIterations; ++i) {
+    beginFlush(rects, kBenchTiles, pixels, kWidth);
+    waitFlush();
+  }
+  benchReport("tiles16", before, ESP.getCycleCount() - start);
 }
 }  // namespace PanelIO
+#endif
@@ -3,12 +3,44 @@
 #include <Arduino.h>
 #include <driver/spi_master.h>
 
+#include "FlushPlanner.h"
 #include "HardwareConfig.h"
 
 namespace PanelIO {
+// Frame size. The panel (TFT_PANEL, PanelDriver.h) may be larger and shows
+// the frame centered; all coordinates here are frame coordinates.
 static const int16_t kWidth = 128;
 static const int16_t kHeight = 160;
 
 bool begin();
+
+// Non-blocking flush. beginFlush() starts streaming rects out of buffer and
+// returns at once; flushBusy() keeps the SPI queue fed and returns false
+// once the last transaction has completed. Until then the caller must not
+// touch rects or draw into buffer. beginFlush() fails while busy. Rects are
+// in screen coordinates; buffer holds screen rows from originY down.
+bool beginFlush(const FlushRect *rects, uint16_t count, const uint16_t *buffer, int16_t stride, int16_t originY = 0);
+bool beginFlush(const FlushRect *rects, uint16_t count, const uint8_t *buffer, int16_t stride, const uint16_t *lut,
+                int16_t originY = 0);
+bool flushBusy();
+void waitFlush();
+
+// Hardware vertical scroll. Screen rows [top, top + rows) become a ring in
+// panel memory: after scrollTo(offset) screen row top shows what was last
+// written for row top + offset. Rects stay in screen coordinates and are
+// remapped, so callers only have to keep their own copy rotated to match.
+// Both wait out any flush in progress first.
+void setScrollArea(int16_t top, int16_t rows);
+void scrollTo(int16_t offset);
+
+// Blocking single-rect pushes; they wait out any flush in progress first.
 void pushRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *buffer, int16_t stride);
+// Indexed framebuffer: every row is expanded through lut (panel-order RGB565).
+void pushRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *buffer, int16_t stride, const uint16_t *lut);
+
+#if PERF_BENCH
+// Prints the cycles an address window and a row of 16x16 tiles take with
+// blocking per-command writes, as the driver used to, and queued.
+void benchRectSetup();
+#endif
 }  // namespace PanelIO
@@ -0,0 +1,221 @@
+#include "PerfBench.h"
+
+#include "Font5x7.h"
+#include "TextCache.h"
+#include "UiFormat.h"
+
+namespace {
+static const uint16_t kIterations = 64;
+
+// Reference kernels matching the original one-pixel-per-store loops.
+void naiveFill(FramePixel *buffer, int16_t stride, int16_t x, int16_t y, int16_t w, int16_t h, FramePixel c) {
+  for (int16_t yy = y; yy < y + h; ++yy) {
+    uint32_t idx = static_cast<uint32_t>(yy) * stride + x;
+    for (int16_t xx = 0; xx < w; ++xx) {
+      buffer[idx + xx] = c;
+    }
+  }
+}
+
+// Reference glyph path: one clipped fillRect per lit font pixel.
+void naiveText(Renderer &renderer, int16_t x, int16_t y, const char *text, uint8_t scale, ColorToken color) {
+  while (*text) {
+    char c = *text++;
+    if (c < 32 || c > 126) c = '?';
+    uint16_t idx = (c - 32) * 5;
+    for (uint8_t i = 0; i < 5; ++i) {
+      uint8_t line = pgm_read_byte(kFont5x7 + idx + i);
+      for (uint8_t j = 0; j < 7; ++j) {
+        if (line & 0x01) {
+          renderer.fillRect(x + (i * scale), y + (j * scale), scale, scale, color);
+        }
+        line >>= 1;
+      }
+    }
+    x += 6 * scale;
+  }
+}
+
+#if !FRAME_INDEXED
+// Reference blend: unpacks each panel-order pixel into channels and mixes
+// them with a multiply per channel.
+void naiveBlend(FramePixel *buffer, int16_t stride, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c,
+                uint8_t alpha) {
+  uint16_t s = static_cast<uint16_t>((c << 8) | (c >> 8));
+  uint8_t sr = s >> 11;
+  uint8_t sg = (s >> 5) & 0x3F;
+  uint8_t sb = s & 0x1F;
+  for (int16_t yy = y; yy < y + h; ++yy) {
+    uint32_t idx = static_cast<uint32_t>(yy) * stride + x;
+    for (int16_t xx = 0; xx < w; ++xx) {
+      uint16_t d = static_cast<uint16_t>((buffer[idx + xx] << 8) | (buffer[idx + xx] >> 8));
+      uint16_t r = (sr * alpha + (d >> 11) * (4 - alpha)) >> 2;
+      uint16_t g = (sg * alpha + ((d >> 5) & 0x3F) * (4 - alpha)) >> 2;
+      uint16_t b = (sb * alpha + (d & 0x1F) * (4 - alpha)) >> 2;
+      uint16_t out = (r << 11) | (g << 5) | b;
+      buffer[idx + xx] = static_cast<uint16_t>((out << 8) | (out >> 8));
+    }
+  }
+}
+#endif
+
+void report(const char *name, uint32_t naiveCycles, uint32_t fastCycles) {
+  uint32_t naiveAvg = naiveCycles / kIterations;
+  uint32_t fastAvg = fastCycles / kIterations;
+  uint32_t pct = naiveAvg ? (fastAvg * 100) / naiveAvg : 0;
+  Serial.printf("bench %-10s naive %7lu cyc  fast %7lu cyc  (%lu%%)\n",
+    name,
+    static_cast<unsigned long>(naiveAvg),
+    static_cast<unsigned long>(fastAvg),
+    static_cast<unsigned long>(pct));
+}
+
+void benchRect(Renderer &renderer, FramePixel *buffer, int16_t stride, const Palette *palette,
+               const char *name, int16_t x, int16_t y, int16_t w, int16_t h) {
+  FramePixel c = palette->pixel(BG_PANEL);
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    naiveFill(buffer, stride, x, y, w, h, c);
+  }
+  uint32_t naive = ESP.getCycleCount() - start;
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    if (h == 1) {
+      renderer.drawHLine(x, y, w, BG_PANEL);
+    } else {
+      renderer.fillRect(x, y, w, h, BG_PANEL);
+    }
+  }
+  report(name, naive, ESP.getCycleCount() - start);
+}
+
+void benchText(Renderer &renderer, const char *name, int16_t x, int16_t y, const char *text, uint8_t scale) {
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    naiveText(renderer, x, y, text, scale, TEXT_PRIMARY);
+  }
+  uint32_t naive = ESP.getCycleCount() - start;
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    renderer.drawText(x, y, text, scale, TEXT_PRIMARY);
+  }
+  report(name, naive, ESP.getCycleCount() - start);
+}
+
+#if !FRAME_INDEXED
+void benchBlend(Renderer &renderer, FramePixel *buffer, int16_t stride, const Palette *palette, const char *name,
+                int16_t x, int16_t y, int16_t w, int16_t h, BlendAlpha alpha) {
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    naiveBlend(buffer, stride, x, y, w, h, palette->pixel(BG_PANEL), alpha);
+  }
+  uint32_t naive = ESP.getCycleCount() - start;
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    renderer.blendRect(x, y, w, h, BG_PANEL, alpha);
+  }
+  report(name, naive, ESP.getCycleCount() - start);
+}
+#endif
+
+// Glyph-by-glyph drawText against the same string served from a warm
+// text-run cache.
+void benchCachedText(Renderer &renderer, const char *name, int16_t x, int16_t y, const char *text, uint8_t scale) {
+  TextCache cache;
+  if (!cache.begin(1024)) return;
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    renderer.drawText(x, y, text, scale, TEXT_PRIMARY);
+  }
+  uint32_t glyphs = ESP.getCycleCount() - start;
+
+  renderer.setTextCache(&cache);
+  renderer.drawText(x, y, text, scale, TEXT_PRIMARY);
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    renderer.drawText(x, y, text, scale, TEXT_PRIMARY);
+  }
+  report(name, glyphs, ESP.getCycleCount() - start);
+  renderer.setTextCache(nullptr);
+}
+
+// snprintf against UiFormat for the status bar's "T%.1f" voltage, both
+// formatting a changing value and through a Field whose value holds.
+void benchFormat() {
+  char buf[12];
+  volatile float volts = 7.4f;
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    snprintf(buf, sizeof(buf), "T%.1f", volts + i * 0.1f);
+  }
+  uint32_t naive = ESP.getCycleCount() - start;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    UiFormat::fixed(buf, sizeof(buf), volts + i * 0.1f, 1, "T");
+  }
+  report("fmt fixed", naive, ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    snprintf(buf, sizeof(buf), "%u", 1000u + i);
+  }
+  naive = ESP.getCycleCount() - start;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    UiFormat::unsignedInt(buf, sizeof(buf), 1000u + i);
+  }
+  report("fmt int", naive, ESP.getCycleCount() - start);
+
+  UiFormat::Field field;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    snprintf(buf, sizeof(buf), "T%.1f", volts);
+  }
+  naive = ESP.getCycleCount() - start;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    field.fixed(volts, 1, "T");
+  }
+  report("fmt field", naive, ESP.getCycleCount() - start);
+}
+}  // namespace
+
+namespace PerfBench {
+void run(Renderer &renderer, FramePixel *buffer, int16_t width, int16_t height, const Palette *palette) {
+  if (!buffer || !palette) return;
+  renderer.setBuffer(buffer, width, height, palette);
+
+  FramePixel c = palette->pixel(BG_PRIMARY);
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    naiveFill(buffer, width, 0, 0, width, height, c);
+  }
+  uint32_t naive = ESP.getCycleCount() - start;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    renderer.clear(BG_PRIMARY);
+  }
+  report("clear", naive, ESP.getCycleCount() - start);
+
+  benchRect(renderer, buffer, width, palette, "panel", 0, 26, width, 40);
+  benchRect(renderer, buffer, width, palette, "row", 0, 40, width, 18);
+  benchRect(renderer, buffer, width, palette, "unaligned", 3, 40, 61, 18);
+  benchRect(renderer, buffer, width, palette, "hline", 1, 57, width - 2, 1);
+  benchRect(renderer, buffer, width, palette, "cell", 5, 60, 3, 3);
+
+#if !FRAME_INDEXED
+  benchBlend(renderer, buffer, width, palette, "blend 75", 16, 36, 96, 56, BLEND_75);
+  benchBlend(renderer, buffer, width, palette, "blend 50", 3, 40, 61, 18, BLEND_50);
+#endif
+
+  benchText(renderer, "label", 6, 45, "EXT TELEMETRY", 1);
+  benchText(renderer, "speed", 56, 34, "088", 3);
+  benchText(renderer, "clipped", 100, 150, "CLIPPED", 2);
+  benchCachedText(renderer, "label$", 6, 45, "EXT TELEMETRY", 1);
+  benchCachedText(renderer, "speed$", 56, 34, "088", 3);
+  benchFormat();
+}
+}  // namespace PerfBench
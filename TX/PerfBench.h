@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "Palette.h"
+#include "Renderer.h"
+
+namespace PerfBench {
+void run(Renderer &renderer, FramePixel *buffer, int16_t width, int16_t height, const Palette *palette);
+}  // namespace PerfBench
@@ -1,39 +1,293 @@
 #include "Renderer.h"
 
+#include "DisplayList.h"
+#include "FixedMath.h"
 #include "Font5x7.h"
+#include "TextCache.h"
 
-Renderer::Renderer() : buffer(nullptr), width(0), height(0), palette(nullptr) {}
+namespace {
+typedef uint32_t __attribute__((__may_alias__)) PixelWord;
 
-void Renderer::setBuffer(uint16_t *buf, int16_t w, int16_t h, const Palette *pal) {
+#if !FRAME_INDEXED
+// Fills count pixels from dst. A leading pixel brings dst to a 32-bit
+// boundary, the body stores two pixels per word eight words at a time, and
+// a trailing pixel finishes odd spans.
+void fillSpan(uint16_t *dst, int32_t count, uint16_t c) {
+  if (count <= 0) return;
+  if ((reinterpret_cast<uintptr_t>(dst) & 0x03) != 0) {
+    *dst++ = c;
+    --count;
+  }
+
+  uint32_t pair = (static_cast<uint32_t>(c) << 16) | c;
+  PixelWord *out = reinterpret_cast<PixelWord *>(dst);
+  int32_t words = count >> 1;
+  while (words >= 8) {
+    out[0] = pair;
+    out[1] = pair;
+    out[2] = pair;
+    out[3] = pair;
+    out[4] = pair;
+    out[5] = pair;
+    out[6] = pair;
+    out[7] = pair;
+    out += 8;
+    words -= 8;
+  }
+  while (words-- > 0) {
+    *out++ = pair;
+  }
+  if (count & 0x01) {
+    *reinterpret_cast<uint16_t *>(out) = c;
+  }
+}
+#else
+// Indexed variant: aligns to a word, then stores four pixels per word.
+void fillSpan(uint8_t *dst, int32_t count, uint8_t c) {
+  while (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 0x03) != 0) {
+    *dst++ = c;
+    --count;
+  }
+
+  uint32_t quad = c * 0x01010101UL;
+  PixelWord *out = reinterpret_cast<PixelWord *>(dst);
+  int32_t words = count >> 2;
+  while (words >= 8) {
+    out[0] = quad;
+    out[1] = quad;
+    out[2] = quad;
+    out[3] = quad;
+    out[4] = quad;
+    out[5] = quad;
+    out[6] = quad;
+    out[7] = quad;
+    out += 8;
+    words -= 8;
+  }
+  while (words-- > 0) {
+    *out++ = quad;
+  }
+  dst = reinterpret_cast<uint8_t *>(out);
+  for (count &= 0x03; count > 0; --count) {
+    *dst++ = c;
+  }
+}
+#endif
+
+#if !FRAME_INDEXED
+// RGB565 blending works on two pixels per word in native order; frame
+// words are byte-swapped on the way in and out, which keeps each pixel in
+// its own half. Masking off the low bit of every field before the shift
+// keeps the halved difference from borrowing into the next field.
+uint32_t swapPixelBytes(uint32_t w) {
+  return ((w & 0x00FF00FFUL) << 8) | ((w >> 8) & 0x00FF00FFUL);
+}
+
+uint32_t averagePair(uint32_t a, uint32_t b) {
+  return (a & b) + (((a ^ b) & 0xF7DEF7DEUL) >> 1);
+}
+
+// 25% and 75% average once more towards the destination or the source.
+uint32_t blendPair(uint32_t src, uint32_t dst, uint8_t alpha) {
+  uint32_t mid = averagePair(src, dst);
+  if (alpha == BLEND_50) return mid;
+  return averagePair((alpha == BLEND_75) ? src : dst, mid);
+}
+
+uint16_t blendPixel(uint16_t src, uint16_t dst, uint8_t alpha) {
+  return static_cast<uint16_t>(swapPixelBytes(blendPair(swapPixelBytes(src), swapPixelBytes(dst), alpha)));
+}
+
+// Blends c over count pixels from dst, a word at a time once dst is
+// aligned. x/y only matter to the indexed variant.
+void blendSpan(uint16_t *dst, int32_t count, uint16_t c, uint8_t alpha, int16_t, int16_t) {
+  if (count <= 0) return;
+  if ((reinterpret_cast<uintptr_t>(dst) & 0x03) != 0) {
+    *dst = blendPixel(c, *dst, alpha);
+    ++dst;
+    --count;
+  }
+  uint32_t pair = swapPixelBytes((static_cast<uint32_t>(c) << 16) | c);
+  PixelWord *out = reinterpret_cast<PixelWord *>(dst);
+  for (int32_t words = count >> 1; words > 0; --words, ++out) {
+    *out = swapPixelBytes(blendPair(pair, swapPixelBytes(*out), alpha));
+  }
+  if (count & 0x01) {
+    uint16_t *last = reinterpret_cast<uint16_t *>(out);
+    *last = blendPixel(c, *last, alpha);
+  }
+}
+
+#else
+// Indexed frames stipple: a pixel takes the source when its 2x2 ordered
+// threshold is below alpha, so 1, 2 or 3 pixels of every 4 do.
+bool stippled(int16_t x, int16_t y, uint8_t alpha) {
+  static const uint8_t kThreshold[4] = {0, 2, 3, 1};
+  return kThreshold[((y & 1) << 1) | (x & 1)] < alpha;
+}
+
+void blendSpan(uint8_t *dst, int32_t count, uint8_t c, uint8_t alpha, int16_t x, int16_t y) {
+  for (int32_t i = 0; i < count; ++i) {
+    if (stippled(x + i, y, alpha)) dst[i] = c;
+  }
+}
+#endif
+
+// Half width of row dy of a filled circle of radius r, or -1 when the row
+// misses it. Pixels with dx*dx + dy*dy <= r*r + r are inside, which keeps
+// small circles round.
+int32_t circleHalfWidth(int32_t r, int32_t dy) {
+  int32_t limit = r * r + r - dy * dy;
+  if (limit < 0) return -1;
+  return static_cast<int32_t>(FixedMath::isqrt(static_cast<uint32_t>(limit)));
+}
+
+// x of the edge (xs, ys)-(xe, ye) on row y, rounded; requires ye > ys.
+int32_t edgeX(int32_t xs, int32_t ys, int32_t xe, int32_t ye, int32_t y) {
+  int32_t den = ye - ys;
+  return xs + FixedMath::floorDiv(2 * (xe - xs) * (y - ys) + den, 2 * den);
+}
+
+int16_t lowest(int16_t a, int16_t b) { return (a < b) ? a : b; }
+int16_t highest(int16_t a, int16_t b) { return (a > b) ? a : b; }
+
+void swapVertex(int16_t &xa, int16_t &ya, int16_t &xb, int16_t &yb) {
+  int16_t t = xa; xa = xb; xb = t;
+  t = ya; ya = yb; yb = t;
+}
+
+// Corners of a thickness-wide band around p0-p1, in order around the quad.
+void thickLineCorners(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t thickness, int16_t *cx, int16_t *cy) {
+  int32_t dx = x1 - x0;
+  int32_t dy = y1 - y0;
+  int32_t len = static_cast<int32_t>(FixedMath::isqrt(static_cast<uint32_t>(dx * dx + dy * dy)));
+  int32_t ox = 0;
+  int32_t oy = 0;
+  if (len > 0) {
+    ox = FixedMath::floorDiv(-dy * thickness + len, 2 * len);
+    oy = FixedMath::floorDiv(dx * thickness + len, 2 * len);
+  }
+  cx[0] = x0 + ox; cy[0] = y0 + oy;
+  cx[1] = x1 + ox; cy[1] = y1 + oy;
+  cx[2] = x1 - ox; cy[2] = y1 - oy;
+  cx[3] = x0 - ox; cy[3] = y0 - oy;
+}
+}  // namespace
+
+Renderer::Renderer()
+    : buffer(nullptr), width(0), height(0), originY(0), bufferRows(0), clipLeft(0), clipTop(0), clipRight(0),
+      clipBottom(0), palette(nullptr), recorder(nullptr), textCache(nullptr), overdraw(nullptr),
+      tileCols(0), tileRows(0) {
+  memset(&damage, 0, sizeof(damage));
+  memset(&prevDamage, 0, sizeof(prevDamage));
+}
+
+void Renderer::setBuffer(FramePixel *buf, int16_t w, int16_t h, const Palette *pal) {
+  setBand(buf, w, h, 0, h, pal);
+}
+
+void Renderer::setBand(FramePixel *buf, int16_t w, int16_t h, int16_t top, int16_t rows, const Palette *pal) {
   buffer = buf;
   width = w;
   height = h;
+  originY = top;
+  bufferRows = (top + rows > h) ? h - top : rows;
   palette = pal;
+  tileCols = (w + kTileW - 1) / kTileW;
+  tileRows = (h + kTileH - 1) / kTileH;
+  resetClip();
+}
+
+void Renderer::setClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+  resetClip();
+  if (x > clipLeft) clipLeft = x;
+  if (y > clipTop) clipTop = y;
+  if (x + w < clipRight) clipRight = x + w;
+  if (y + h < clipBottom) clipBottom = y + h;
+  if (clipRight < clipLeft) clipRight = clipLeft;
+  if (clipBottom < clipTop) clipBottom = clipTop;
+}
+
+void Renderer::resetClip() {
+  clipLeft = 0;
+  clipTop = originY;
+  clipRight = width;
+  clipBottom = originY + bufferRows;
+}
+
+void Renderer::beginFrame() {
+  prevDamage = damage;
+  memset(&damage, 0, sizeof(damage));
+}
+
+bool Renderer::tileMayDiffer(int16_t tx, int16_t ty) const {
+  // A tile nobody drew into is the clear color; it can only match the
+  // previous frame without a compare if that frame left it the same color.
+  if (!damage.cleared || !prevDamage.cleared) return true;
+  if (damage.clearColor != prevDamage.clearColor) return true;
+  uint16_t tile = static_cast<uint16_t>(ty * tileCols + tx);
+  if (tile >= kMaxTiles) return true;
+  uint32_t bit = 1UL << (tile & 31);
+  return ((damage.tiles[tile >> 5] | prevDamage.tiles[tile >> 5]) & bit) != 0;
+}
+
+void Renderer::markDamage(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int16_t tx0 = x / kTileW;
+  int16_t tx1 = (x + w - 1) / kTileW;
+  int16_t ty0 = y / kTileH;
+  int16_t ty1 = (y + h - 1) / kTileH;
+  for (int16_t ty = ty0; ty <= ty1; ++ty) {
+    uint16_t tile = static_cast<uint16_t>(ty * tileCols + tx0);
+    for (int16_t tx = tx0; tx <= tx1 && tile < kMaxTiles; ++tx, ++tile) {
+      damage.tiles[tile >> 5] |= 1UL << (tile & 31);
+    }
+  }
 }
 
 void Renderer::clear(ColorToken color) {
+  if (recorder) {
+    recorder->add(DisplayList::OP_CLEAR, 0, 0, width, height, color);
+    return;
+  }
   if (!buffer || !palette) return;
-  uint16_t c = palette->color(color);
-  for (int32_t i = 0; i < width * height; ++i) {
-    buffer[i] = c;
+  // Only a clear of the whole screen resets damage; a clipped clear is an
+  // ordinary fill of the clip rectangle.
+  if (clipLeft != 0 || clipTop != 0 || clipRight != width || clipBottom != height) {
+    fillRect(clipLeft, clipTop, clipRight - clipLeft, clipBottom - clipTop, color);
+    return;
   }
+  FramePixel c = palette->pixel(color);
+  countWrites(OVERDRAW_CLEAR, 0, 0, width, height);
+  fillSpan(buffer, static_cast<int32_t>(width) * height, c);
+  memset(damage.tiles, 0, sizeof(damage.tiles));
+  damage.cleared = true;
+  damage.clearColor = c;
 }
 
 void Renderer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, ColorToken color) {
-  if (!buffer || !palette) return;
   if (w <= 0 || h <= 0) return;
-  if (x < 0) { w += x; x = 0; }
-  if (y < 0) { h += y; y = 0; }
-  if (x + w > width) w = width - x;
-  if (y + h > height) h = height - y;
+  if (recorder) {
+    recorder->add(DisplayList::OP_FILL, x, y, w, h, color);
+    return;
+  }
+  if (!buffer || !palette) return;
+  if (x < clipLeft) { w -= clipLeft - x; x = clipLeft; }
+  if (y < clipTop) { h -= clipTop - y; y = clipTop; }
+  if (x + w > clipRight) w = clipRight - x;
+  if (y + h > clipBottom) h = clipBottom - y;
   if (w <= 0 || h <= 0) return;
 
-  uint16_t c = palette->color(color);
-  for (int16_t yy = y; yy < y + h; ++yy) {
-    uint32_t idx = static_cast<uint32_t>(yy) * width + x;
-    for (int16_t xx = 0; xx < w; ++xx) {
-      buffer[idx + xx] = c;
-    }
+  markDamage(x, y, w, h);
+  countWrites(OVERDRAW_FILL, x, y, w, h);
+  FramePixel c = palette->pixel(color);
+  FramePixel *row = pixelAt(x, y);
+  if (w == width) {
+    fillSpan(row, static_cast<int32_t>(w) * h, c);
+    return;
+  }
+  for (int16_t yy = 0; yy < h; ++yy) {
+    fillSpan(row, w, c);
+    row += width;
   }
 }
 
@@ -45,35 +299,55 @@ void Renderer::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, ColorToken c
 }
 
 void Renderer::drawHLine(int16_t x, int16_t y, int16_t w, ColorToken color) {
+  if (recorder) {
+    if (w > 0) recorder->add(DisplayList::OP_HLINE, x, y, w, 1, color);
+    return;
+  }
   if (!buffer || !palette) return;
-  if (y < 0 || y >= height || w <= 0) return;
-  if (x < 0) { w += x; x = 0; }
-  if (x + w > width) w = width - x;
+  if (y < clipTop || y >= clipBottom || w <= 0) return;
+  if (x < clipLeft) { w -= clipLeft - x; x = clipLeft; }
+  if (x + w > clipRight) w = clipRight - x;
   if (w <= 0) return;
 
-  uint16_t c = palette->color(color);
-  uint32_t idx = static_cast<uint32_t>(y) * width + x;
-  for (int16_t i = 0; i < w; ++i) {
-    buffer[idx + i] = c;
-  }
+  markDamage(x, y, w, 1);
+  countWrites(OVERDRAW_LINE, x, y, w, 1);
+  fillSpan(pixelAt(x, y), w, palette->pixel(color));
 }
 
 void Renderer::drawVLine(int16_t x, int16_t y, int16_t h, ColorToken color) {
+  if (recorder) {
+    if (h > 0) recorder->add(DisplayList::OP_VLINE, x, y, 1, h, color);
+    return;
+  }
   if (!buffer || !palette) return;
-  if (x < 0 || x >= width || h <= 0) return;
-  if (y < 0) { h += y; y = 0; }
-  if (y + h > height) h = height - y;
+  if (x < clipLeft || x >= clipRight || h <= 0) return;
+  if (y < clipTop) { h -= clipTop - y; y = clipTop; }
+  if (y + h > clipBottom) h = clipBottom - y;
   if (h <= 0) return;
 
-  uint16_t c = palette->color(color);
-  uint32_t idx = static_cast<uint32_t>(y) * width + x;
-  for (int16_t i = 0; i < h; ++i) {
-    buffer[idx + i * width] = c;
+  markDamage(x, y, 1, h);
+  countWrites(OVERDRAW_LINE, x, y, 1, h);
+  FramePixel c = palette->pixel(color);
+  FramePixel *dst = pixelAt(x, y);
+  for (int16_t i = 0; i < h; ++i, dst += width) {
+    *dst = c;
   }
 }
 
 void Renderer::drawText(int16_t x, int16_t y, const char *text, uint8_t scale, ColorToken color) {
   if (!text || scale == 0) return;
+  if (recorder) {
+    if (*text) recorder->addText(x, y, textWidth(text, scale), 7 * scale, text, scale, color);
+    return;
+  }
+  if (textCache) {
+    uint16_t count = 0;
+    const TextSpan *spans = textCache->spans(text, count);
+    if (spans) {
+      drawSpans(x, y, textWidth(text, scale), spans, count, scale, color);
+      return;
+    }
+  }
   while (*text) {
     drawChar(x, y, *text, scale, color);
     x += (6 * scale);
@@ -101,6 +375,191 @@ int16_t Renderer::textHeight(uint8_t scale) const {
   return static_cast<int16_t>(8 * scale);
 }
 
+bool Renderer::beginShape(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (!buffer || !palette) return false;
+  if (x < clipLeft) { w -= clipLeft - x; x = clipLeft; }
+  if (y < clipTop) { h -= clipTop - y; y = clipTop; }
+  if (x + w > clipRight) w = clipRight - x;
+  if (y + h > clipBottom) h = clipBottom - y;
+  if (w <= 0 || h <= 0) return false;
+  markDamage(x, y, w, h);
+  return true;
+}
+
+void Renderer::fillRow(int16_t x0, int16_t x1, int16_t y, FramePixel c) {
+  if (y < clipTop || y >= clipBottom) return;
+  if (x0 < clipLeft) x0 = clipLeft;
+  if (x1 >= clipRight) x1 = clipRight - 1;
+  if (x0 > x1) return;
+  countWrites(OVERDRAW_SHAPE, x0, y, x1 - x0 + 1, 1);
+  fillSpan(pixelAt(x0, y), x1 - x0 + 1, c);
+}
+
+void Renderer::fillCircle(int16_t cx, int16_t cy, int16_t r, ColorToken color) {
+  if (r < 0) return;
+  if (recorder) {
+    const int16_t params[] = {cx, cy, r};
+    recorder->addShape(DisplayList::OP_CIRCLE, cx - r, cy - r, 2 * r + 1, 2 * r + 1, params, 3, color);
+    return;
+  }
+  if (!beginShape(cx - r, cy - r, 2 * r + 1, 2 * r + 1)) return;
+  FramePixel c = palette->pixel(color);
+  for (int16_t dy = -r; dy <= r; ++dy) {
+    int32_t half = circleHalfWidth(r, dy);
+    if (half >= 0) fillRow(cx - half, cx + half, cy + dy, c);
+  }
+}
+
+void Renderer::fillArc(int16_t cx, int16_t cy, int16_t rOuter, int16_t rInner, int16_t startDeg, int16_t endDeg,
+                       ColorToken color) {
+  if (rOuter < 0 || endDeg <= startDeg) return;
+  if (recorder) {
+    const int16_t params[] = {cx, cy, rOuter, rInner, startDeg, endDeg};
+    recorder->addShape(DisplayList::OP_ARC, cx - rOuter, cy - rOuter, 2 * rOuter + 1, 2 * rOuter + 1, params, 6,
+                       color);
+    return;
+  }
+  if (!beginShape(cx - rOuter, cy - rOuter, 2 * rOuter + 1, 2 * rOuter + 1)) return;
+  FramePixel c = palette->pixel(color);
+  // Each piece is bounded by two half-planes, which needs a sweep <= 90.
+  for (int32_t a = startDeg; a < endDeg;) {
+    int32_t b = (endDeg - a > 90) ? a + 90 : endDeg;
+    fillArcPiece(cx, cy, rOuter, rInner, a, b, c);
+    a = b;
+  }
+}
+
+// Fills the ring pixels p with cross(start, p) >= 0 and cross(p, end) > 0.
+// Each half-plane bounds dx linearly per row, so every ring span is
+// clipped to one [lo, hi] range.
+void Renderer::fillArcPiece(int16_t cx, int16_t cy, int16_t rOuter, int16_t rInner, int32_t startDeg,
+                            int32_t endDeg, FramePixel c) {
+  const int32_t ax = FixedMath::cosDeg(startDeg);
+  const int32_t ay = FixedMath::sinDeg(startDeg);
+  const int32_t bx = FixedMath::cosDeg(endDeg);
+  const int32_t by = FixedMath::sinDeg(endDeg);
+
+  for (int32_t dy = -rOuter; dy <= rOuter; ++dy) {
+    int32_t outer = circleHalfWidth(rOuter, dy);
+    if (outer < 0) continue;
+    int32_t lo = -outer;
+    int32_t hi = outer;
+    if (ay > 0) {
+      int32_t bound = FixedMath::floorDiv(ax * dy, ay);
+      if (bound < hi) hi = bound;
+    } else if (ay < 0) {
+      int32_t bound = FixedMath::ceilDiv(ax * dy, ay);
+      if (bound > lo) lo = bound;
+    } else if (ax * dy < 0) {
+      continue;
+    }
+    if (by > 0) {
+      int32_t bound = FixedMath::floorDiv(bx * dy, by) + 1;
+      if (bound > lo) lo = bound;
+    } else if (by < 0) {
+      int32_t bound = FixedMath::ceilDiv(bx * dy, by) - 1;
+      if (bound < hi) hi = bound;
+    } else if (bx * dy >= 0) {
+      continue;
+    }
+    if (lo > hi) continue;
+
+    int32_t inner = circleHalfWidth(rInner, dy);
+    if (inner < 0) {
+      fillRow(cx + lo, cx + hi, cy + dy, c);
+      continue;
+    }
+    if (lo < -inner) fillRow(cx + lo, cx + ((hi < -inner - 1) ? hi : -inner - 1), cy + dy, c);
+    if (hi > inner) fillRow(cx + ((lo > inner + 1) ? lo : inner + 1), cx + hi, cy + dy, c);
+  }
+}
+
+void Renderer::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, ColorToken color) {
+  if (w <= 0 || h <= 0) return;
+  if (r > w / 2) r = w / 2;
+  if (r > h / 2) r = h / 2;
+  if (r < 0) r = 0;
+  if (recorder) {
+    const int16_t params[] = {r};
+    recorder->addShape(DisplayList::OP_ROUND_RECT, x, y, w, h, params, 1, color);
+    return;
+  }
+  if (!beginShape(x, y, w, h)) return;
+  FramePixel c = palette->pixel(color);
+  for (int16_t i = 0; i < h; ++i) {
+    int32_t dy = 0;
+    if (i < r) dy = r - i;
+    if (i >= h - r) dy = i - (h - 1 - r);
+    int32_t inset = dy ? r - circleHalfWidth(r, dy) : 0;
+    fillRow(x + inset, x + w - 1 - inset, y + i, c);
+  }
+}
+
+void Renderer::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                            ColorToken color) {
+  int16_t minX = lowest(x0, lowest(x1, x2));
+  int16_t maxX = highest(x0, highest(x1, x2));
+  int16_t minY = lowest(y0, lowest(y1, y2));
+  int16_t maxY = highest(y0, highest(y1, y2));
+  if (recorder) {
+    const int16_t params[] = {x0, y0, x1, y1, x2, y2};
+    recorder->addShape(DisplayList::OP_TRIANGLE, minX, minY, maxX - minX + 1, maxY - minY + 1, params, 6, color);
+    return;
+  }
+  if (!beginShape(minX, minY, maxX - minX + 1, maxY - minY + 1)) return;
+  rasterTriangle(x0, y0, x1, y1, x2, y2, palette->pixel(color));
+}
+
+// Scanline fill between the long edge and the two short ones; vertices on
+// a row widen that row's span, which covers flat and degenerate triangles.
+void Renderer::rasterTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                              FramePixel c) {
+  if (y0 > y1) swapVertex(x0, y0, x1, y1);
+  if (y1 > y2) swapVertex(x1, y1, x2, y2);
+  if (y0 > y1) swapVertex(x0, y0, x1, y1);
+
+  int16_t yStart = (y0 < clipTop) ? clipTop : y0;
+  int16_t yEnd = (y2 >= clipBottom) ? clipBottom - 1 : y2;
+  for (int16_t y = yStart; y <= yEnd; ++y) {
+    int32_t xa = (y2 > y0) ? edgeX(x0, y0, x2, y2, y) : x0;
+    int32_t xb;
+    if (y < y1) {
+      xb = edgeX(x0, y0, x1, y1, y);
+    } else {
+      xb = (y2 > y1) ? edgeX(x1, y1, x2, y2, y) : x1;
+    }
+    int32_t lo = (xa < xb) ? xa : xb;
+    int32_t hi = (xa < xb) ? xb : xa;
+    if (y == y0) { if (x0 < lo) lo = x0; if (x0 > hi) hi = x0; }
+    if (y == y1) { if (x1 < lo) lo = x1; if (x1 > hi) hi = x1; }
+    if (y == y2) { if (x2 < lo) lo = x2; if (x2 > hi) hi = x2; }
+    if (lo < clipLeft) lo = clipLeft;
+    if (hi >= clipRight) hi = clipRight - 1;
+    if (lo > hi) continue;
+    countWrites(OVERDRAW_SHAPE, lo, y, hi - lo + 1, 1);
+    fillSpan(pixelAt(lo, y), hi - lo + 1, c);
+  }
+}
+
+void Renderer::drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t thickness, ColorToken color) {
+  int16_t qx[4];
+  int16_t qy[4];
+  thickLineCorners(x0, y0, x1, y1, thickness, qx, qy);
+  int16_t minX = lowest(lowest(qx[0], qx[1]), lowest(qx[2], qx[3]));
+  int16_t maxX = highest(highest(qx[0], qx[1]), highest(qx[2], qx[3]));
+  int16_t minY = lowest(lowest(qy[0], qy[1]), lowest(qy[2], qy[3]));
+  int16_t maxY = highest(highest(qy[0], qy[1]), highest(qy[2], qy[3]));
+  if (recorder) {
+    const int16_t params[] = {x0, y0, x1, y1, thickness};
+    recorder->addShape(DisplayList::OP_THICK_LINE, minX, minY, maxX - minX + 1, maxY - minY + 1, params, 5, color);
+    return;
+  }
+  if (!beginShape(minX, minY, maxX - minX + 1, maxY - minY + 1)) return;
+  FramePixel c = palette->pixel(color);
+  rasterTriangle(qx[0], qy[0], qx[1], qy[1], qx[2], qy[2], c);
+  rasterTriangle(qx[0], qy[0], qx[2], qy[2], qx[3], qy[3], c);
+}
+
 void Renderer::drawVBar(int16_t x, int16_t y, int16_t w, int16_t h, int16_t pct, ColorToken fill, ColorToken track) {
   if (pct < -100) pct = -100;
   if (pct > 100) pct = 100;
@@ -134,19 +593,144 @@ void Renderer::drawValueBox(int16_t x, int16_t y, int16_t w, int16_t h, const ch
   drawText(x + 4, ty, text, 1, focused ? TEXT_INVERT : TEXT_PRIMARY);
 }
 
+void Renderer::blit(const FramePixel *src, int16_t x, int16_t y, int16_t w, int16_t h, int16_t stride,
+                    uint16_t revision) {
+  if (!src || w <= 0 || h <= 0) return;
+  int16_t srcStride = stride ? stride : w;
+  if (recorder) {
+    recorder->addBlit(x, y, w, h, src, srcStride, revision);
+    return;
+  }
+  if (!buffer) return;
+  if (x < clipLeft) { src += clipLeft - x; w -= clipLeft - x; x = clipLeft; }
+  if (y < clipTop) { src += static_cast<int32_t>(clipTop - y) * srcStride; h -= clipTop - y; y = clipTop; }
+  if (x + w > clipRight) w = clipRight - x;
+  if (y + h > clipBottom) h = clipBottom - y;
+  if (w <= 0 || h <= 0) return;
+
+  markDamage(x, y, w, h);
+  countWrites(OVERDRAW_BLIT, x, y, w, h);
+  FramePixel *dst = pixelAt(x, y);
+  for (int16_t yy = 0; yy < h; ++yy) {
+    memcpy(dst, src, w * sizeof(FramePixel));
+    dst += width;
+    src += srcStride;
+  }
+}
+
+void Renderer::blendRect(int16_t x, int16_t y, int16_t w, int16_t h, ColorToken color, BlendAlpha alpha) {
+  if (w <= 0 || h <= 0) return;
+  if (recorder) {
+    int16_t level = alpha;
+    recorder->addShape(DisplayList::OP_BLEND, x, y, w, h, &level, 1, color);
+    return;
+  }
+  if (!buffer || !palette) return;
+  if (x < clipLeft) { w -= clipLeft - x; x = clipLeft; }
+  if (y < clipTop) { h -= clipTop - y; y = clipTop; }
+  if (x + w > clipRight) w = clipRight - x;
+  if (y + h > clipBottom) h = clipBottom - y;
+  if (w <= 0 || h <= 0) return;
+
+  markDamage(x, y, w, h);
+  countWrites(OVERDRAW_BLEND, x, y, w, h);
+  FramePixel c = palette->pixel(color);
+  FramePixel *row = pixelAt(x, y);
+  for (int16_t yy = y; yy < y + h; ++yy) {
+    blendSpan(row, w, c, alpha, x, yy);
+    row += width;
+  }
+}
+
+void Renderer::drawSpans(int16_t x, int16_t y, int16_t w, const TextSpan *spans, uint16_t count, uint8_t scale,
+                         ColorToken color) {
+  if (!buffer || !palette) return;
+  int16_t h = 7 * scale;
+  if (x >= clipRight || y >= clipBottom || x + w <= clipLeft || y + h <= clipTop) return;
+
+  int16_t top = (y < clipTop) ? clipTop : y;
+  int16_t bottom = (y + h > clipBottom) ? clipBottom : y + h;
+  int16_t left = (x < clipLeft) ? clipLeft : x;
+  int16_t right = (x + w > clipRight) ? clipRight : x + w;
+  markDamage(left, top, right - left, bottom - top);
+  FramePixel px = palette->pixel(color);
+
+  for (uint16_t i = 0; i < count; ++i) {
+    const TextSpan &s = spans[i];
+    int16_t y0 = y + s.row * scale;
+    int16_t y1 = y0 + scale;
+    int16_t x0 = x + s.x0 * scale;
+    int16_t x1 = x + s.x1 * scale;
+    if (y0 < top) y0 = top;
+    if (y1 > bottom) y1 = bottom;
+    if (x0 < left) x0 = left;
+    if (x1 > right) x1 = right;
+    if (y0 >= y1 || x0 >= x1) continue;
+
+    countWrites(OVERDRAW_TEXT, x0, y0, x1 - x0, y1 - y0);
+    FramePixel *dst = pixelAt(x0, y0);
+    for (int16_t yy = y0; yy < y1; ++yy) {
+      fillSpan(dst, x1 - x0, px);
+      dst += width;
+    }
+  }
+}
+
 void Renderer::drawChar(int16_t x, int16_t y, char c, uint8_t scale, ColorToken color) {
   if (!buffer || !palette) return;
+  int16_t glyphW = 5 * scale;
+  int16_t glyphH = 7 * scale;
+  if (x >= clipRight || y >= clipBottom || x + glyphW <= clipLeft || y + glyphH <= clipTop) return;
   if (c < 32 || c > 126) c = '?';
+
+  // Transpose the column-major font into one 5-bit mask per glyph row.
+  uint8_t rows[7] = {0, 0, 0, 0, 0, 0, 0};
+  uint8_t lit = 0;
   uint16_t idx = (c - 32) * 5;
   for (uint8_t i = 0; i < 5; ++i) {
     uint8_t line = pgm_read_byte(kFont5x7 + idx + i);
+    lit |= line;
     for (uint8_t j = 0; j < 7; ++j) {
-      if (line & 0x01) {
-        int16_t px = x + (i * scale);
-        int16_t py = y + (j * scale);
-        fillRect(px, py, scale, scale, color);
+      rows[j] |= ((line >> j) & 0x01) << i;
+    }
+  }
+  if (!lit) return;
+
+  int16_t top = (y < clipTop) ? clipTop : y;
+  int16_t bottom = (y + glyphH > clipBottom) ? clipBottom : y + glyphH;
+  int16_t left = (x < clipLeft) ? clipLeft : x;
+  int16_t right = (x + glyphW > clipRight) ? clipRight : x + glyphW;
+  markDamage(left, top, right - left, bottom - top);
+  FramePixel px = palette->pixel(color);
+
+  for (uint8_t j = 0; j < 7; ++j) {
+    uint8_t mask = rows[j];
+    if (!mask) continue;
+    int16_t y0 = y + j * scale;
+    int16_t y1 = y0 + scale;
+    if (y0 < top) y0 = top;
+    if (y1 > bottom) y1 = bottom;
+    if (y0 >= y1) continue;
+
+    uint8_t i = 0;
+    while (mask) {
+      while (!(mask & 0x01)) { mask >>= 1; ++i; }
+      uint8_t run = 0;
+      while (mask & 0x01) { mask >>= 1; ++run; }
+
+      int16_t x0 = x + i * scale;
+      int16_t x1 = x0 + run * scale;
+      i += run;
+      if (x0 < left) x0 = left;
+      if (x1 > right) x1 = right;
+      if (x0 >= x1) continue;
+
+      countWrites(OVERDRAW_TEXT, x0, y0, x1 - x0, y1 - y0);
+      FramePixel *dst = pixelAt(x0, y0);
+      for (int16_t yy = y0; yy < y1; ++yy) {
+        fillSpan(dst, x1 - x0, px);
+        dst += width;
       }
-      line >>= 1;
     }
   }
 }
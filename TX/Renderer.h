@@ -1,13 +1,45 @@
 #pragma once
 
 #include <Arduino.h>
+#include "HardwareConfig.h"
+#include "Overdraw.h"
 #include "Palette.h"
 
+class DisplayList;
+class TextCache;
+struct TextSpan;
+
+// Coverage of the color in blended fills, in quarters.
+enum BlendAlpha : uint8_t {
+  BLEND_25 = 1,
+  BLEND_50 = 2,
+  BLEND_75 = 3
+};
+
 class Renderer {
 public:
+  static const int16_t kTileW = FRAME_TILE_W;
+  static const int16_t kTileH = FRAME_TILE_H;
+  static const uint16_t kMaxTiles = 512;
+
   Renderer();
 
-  void setBuffer(uint16_t *buffer, int16_t width, int16_t height, const Palette *palette);
+  void setBuffer(FramePixel *buffer, int16_t width, int16_t height, const Palette *palette);
+  // Band mode: buffer holds only screen rows [originY, originY + rows) of a
+  // width x height screen. Drawing still uses screen coordinates.
+  void setBand(FramePixel *buffer, int16_t width, int16_t height, int16_t originY, int16_t rows,
+               const Palette *palette);
+  // Restricts drawing to a screen rectangle inside the buffer's rows.
+  void setClip(int16_t x, int16_t y, int16_t w, int16_t h);
+  void resetClip();
+  // While a list is set, primitives append commands to it instead of drawing.
+  void setRecorder(DisplayList *list) { recorder = list; }
+  bool recording() const { return recorder != nullptr; }
+  const Palette *activePalette() const { return palette; }
+  // Strings the cache can hold are drawn from their cached spans.
+  void setTextCache(TextCache *cache) { textCache = cache; }
+  // With RENDER_OVERDRAW, every pixel write is counted in map.
+  void setOverdraw(OverdrawMap *map) { overdraw = map; }
 
   void clear(ColorToken color);
   void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, ColorToken color);
@@ -20,15 +52,85 @@ public:
   int16_t textWidth(const char *text, uint8_t scale) const;
   int16_t textHeight(uint8_t scale) const;
 
+  // Span-filled shapes, rasterized with integer math. Arcs fill the ring
+  // between rInner and rOuter for angles in [startDeg, endDeg), clockwise
+  // from +x; arcs that share an end angle neither overlap nor leave a gap.
+  void fillCircle(int16_t cx, int16_t cy, int16_t r, ColorToken color);
+  void fillArc(int16_t cx, int16_t cy, int16_t rOuter, int16_t rInner, int16_t startDeg, int16_t endDeg,
+               ColorToken color);
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, ColorToken color);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, ColorToken color);
+  void drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t thickness, ColorToken color);
+
   void drawVBar(int16_t x, int16_t y, int16_t w, int16_t h, int16_t pct, ColorToken fill, ColorToken track);
   void drawHBar(int16_t x, int16_t y, int16_t w, int16_t h, int16_t pct, ColorToken fill, ColorToken track);
   void drawValueBox(int16_t x, int16_t y, int16_t w, int16_t h, const char *text, bool focused);
+  // Copies a w x h block of pixels, rows stride apart (0: w), to x, y. A
+  // recording renderer keeps the pointer along with revision, which the
+  // owner changes whenever the pixels do; they must outlive the replay.
+  void blit(const FramePixel *src, int16_t x, int16_t y, int16_t w, int16_t h, int16_t stride = 0,
+            uint16_t revision = 0);
+
+  // Mixes color over what is already in the frame. RGB565 frames blend
+  // two pixels per word; indexed frames have no colors to mix and stipple
+  // the color with a 2x2 ordered pattern instead.
+  void blendRect(int16_t x, int16_t y, int16_t w, int16_t h, ColorToken color, BlendAlpha alpha);
+
+  // Damage tracking. Primitives mark the tiles they write; beginFrame()
+  // moves the current frame's marks into history so tileMayDiffer() can
+  // answer against the previous frame without reading pixels.
+  void beginFrame();
+  bool tileMayDiffer(int16_t tx, int16_t ty) const;
+  int16_t tilesX() const { return tileCols; }
+  int16_t tilesY() const { return tileRows; }
 
 private:
+  static const uint16_t kDamageWords = kMaxTiles / 32;
+
+  struct Damage {
+    uint32_t tiles[kDamageWords];
+    bool cleared;
+    FramePixel clearColor;
+  };
+
   void drawChar(int16_t x, int16_t y, char c, uint8_t scale, ColorToken color);
+  void drawSpans(int16_t x, int16_t y, int16_t w, const TextSpan *spans, uint16_t count, uint8_t scale,
+                 ColorToken color);
+  void markDamage(int16_t x, int16_t y, int16_t w, int16_t h);
+  // Marks the clipped bounding box of a shape; false when none of it shows.
+  bool beginShape(int16_t x, int16_t y, int16_t w, int16_t h);
+  // Fills columns [x0, x1] of row y, clipped, without marking damage.
+  void fillRow(int16_t x0, int16_t x1, int16_t y, FramePixel c);
+  void fillArcPiece(int16_t cx, int16_t cy, int16_t rOuter, int16_t rInner, int32_t startDeg, int32_t endDeg,
+                    FramePixel c);
+  void rasterTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, FramePixel c);
+  void countWrites(OverdrawKind kind, int16_t x, int16_t y, int16_t w, int16_t h) {
+#if RENDER_OVERDRAW
+    if (overdraw) overdraw->add(kind, x, y, w, h);
+#else
+    (void)kind; (void)x; (void)y; (void)w; (void)h;
+#endif
+  }
+  FramePixel *pixelAt(int16_t x, int16_t y) const {
+    return buffer + static_cast<int32_t>(y - originY) * width + x;
+  }
 
-  uint16_t *buffer;
+  FramePixel *buffer;
   int16_t width;
   int16_t height;
+  int16_t originY;
+  int16_t bufferRows;
+  int16_t clipLeft;
+  int16_t clipTop;
+  int16_t clipRight;
+  int16_t clipBottom;
   const Palette *palette;
+  DisplayList *recorder;
+  TextCache *textCache;
+  OverdrawMap *overdraw;
+
+  int16_t tileCols;
+  int16_t tileRows;
+  Damage damage;
+  Damage prevDamage;
 };
@@ -4,25 +4,35 @@
 #include "UiLayout.h"
 #include "UiStrings.h"
 
-void ScreenAccessoryControl_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"HEADLIGHTS", "TAILLIGHTS", "TURN SIG", "BRAKE", "AUX OUT"};
-  UiDrawListHeader(renderer, "ACCESSORY CTRL");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_ACCESSORY_CTRL];
+namespace {
+const char *fmtTriState(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::triStateLabel(static_cast<AccessoryTriState>(value));
+}
 
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 5) break;
-    const char *value = "";
-    char buf[8];
-    if (idx == 0) value = UiStrings::triStateLabel(state.headlights);
-    else if (idx == 1) value = UiStrings::onOffLabel(state.taillights == ACC_ON);
-    else if (idx == 2) value = UiStrings::turnLabel(state.turnSignals);
-    else if (idx == 3) value = UiStrings::brakeLabel(state.brakeLights);
-    else if (idx == 4) { snprintf(buf, sizeof(buf), "%u", state.auxOutput); value = buf; }
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_ACCESSORY_CTRL], false);
-  }
-  if (visible > 5 && ctx.confirmUntilMs > millis()) {
+const char *fmtTurn(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::turnLabel(static_cast<TurnSignalState>(value));
+}
+
+const char *fmtBrake(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::brakeLabel(static_cast<BrakeState>(value));
+}
+
+void drawApplied(Renderer &renderer, const UiState &, const UiContext &ctx) {
+  int visible = UiLayout::ListH / UiLayout::ItemH;
+  if (visible > 5 && ctx.confirmUntilMs > millis() && UiDrawDynamic()) {
     renderer.drawText(6, UiLayout::ListY + (5 * UiLayout::ItemH) + 4, "APPLIED", 1, STATE_OK);
   }
 }
+
+constexpr UiItem kItems[] = {
+  UiItemCycle("HEADLIGHTS", UI_FIELD(headlights), 3, fmtTriState),
+  UiItemCycle("TAILLIGHTS", UI_FIELD(taillights), 2, UiFmtOnOff),
+  UiItemCycle("TURN SIG", UI_FIELD(turnSignals), 4, fmtTurn),
+  UiItemCycle("BRAKE", UI_FIELD(brakeLights), 2, fmtBrake),
+  UiItemCycle("AUX OUT", UI_FIELD(auxOutput), 4, UiFmtInt),
+};
+}  // namespace
+
+const UiScreenDesc ScreenAccessoryControl_Desc = {
+  "ACCESSORY CTRL", kItems, UI_ITEM_COUNT(kItems), UI_DEP_SETTINGS, UI_REFRESH_5HZ, true, true, nullptr, drawApplied, nullptr, nullptr
+};
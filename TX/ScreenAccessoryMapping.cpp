@@ -1,39 +1,53 @@
 #include "ScreenAccessoryMapping.h"
 
 #include "UiDraw.h"
+#include "UiFormat.h"
 #include "UiLayout.h"
 #include "UiStrings.h"
 
-void ScreenAccessoryMapping_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"HEADLIGHTS", "TAILLIGHTS", "TURN SIG", "BRAKE", "AUX OUT"};
-  UiDrawListHeader(renderer, "ACCESSORY MAP");
-  bool conflict[5] = {false, false, false, false, false};
-  for (int i = 0; i < 5; ++i) {
-    for (int j = i + 1; j < 5; ++j) {
-      if (state.accessoryMap[i] == state.accessoryMap[j] && state.accessoryMap[i] != 5) {
-        conflict[i] = true;
-        conflict[j] = true;
-      }
-    }
+namespace {
+static const uint8_t kUnmapped = 5;
+
+template <uint8_t slot>
+int32_t mapGet(const UiState &state) {
+  return state.accessoryMap[slot];
+}
+
+template <uint8_t slot>
+void mapSet(UiState &state, int32_t value) {
+  state.accessoryMap[slot] = static_cast<uint8_t>(value);
+}
+
+// Marks a source that is shared with another accessory with "!".
+const char *fmtMap(const UiItem &, const UiState &state, int32_t value, char *buf, size_t size) {
+  const char *base = UiStrings::mapLabel(static_cast<uint8_t>(value));
+  if (value == kUnmapped) return base;
+  uint8_t users = 0;
+  for (uint8_t i = 0; i < sizeof(state.accessoryMap); ++i) {
+    if (state.accessoryMap[i] == value) users++;
   }
+  if (users < 2) return base;
+  size_t n = UiFormat::text(buf, size, base);
+  UiFormat::text(buf + n, size - n, "!");
+  return buf;
+}
 
+void drawPriority(Renderer &renderer, const UiState &, const UiContext &) {
   int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_ACCESSORY_MAP];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 5) break;
-    const char *value = "";
-    char buf[10];
-    const char *base = UiStrings::mapLabel(state.accessoryMap[idx]);
-    if (conflict[idx]) {
-      snprintf(buf, sizeof(buf), "%s!", base);
-      value = buf;
-    } else {
-      value = base;
-    }
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_ACCESSORY_MAP], ctx.editMode[SCREEN_ACCESSORY_MAP]);
-  }
-  if (visible > 5) {
+  if (visible > 5 && UiDrawStatic()) {
     renderer.drawText(6, UiLayout::ListY + (5 * UiLayout::ItemH) + 4, "PRIO M>S>T>G", 1, TEXT_MUTED);
   }
 }
+
+constexpr UiItem kItems[] = {
+  UiItemCycle("HEADLIGHTS", mapGet<0>, mapSet<0>, 6, fmtMap),
+  UiItemCycle("TAILLIGHTS", mapGet<1>, mapSet<1>, 6, fmtMap),
+  UiItemCycle("TURN SIG", mapGet<2>, mapSet<2>, 6, fmtMap),
+  UiItemCycle("BRAKE", mapGet<3>, mapSet<3>, 6, fmtMap),
+  UiItemCycle("AUX OUT", mapGet<4>, mapSet<4>, 6, fmtMap),
+};
+}  // namespace
+
+const UiScreenDesc ScreenAccessoryMapping_Desc = {
+  "ACCESSORY MAP", kItems, UI_ITEM_COUNT(kItems), UI_DEP_SETTINGS, UI_REFRESH_5HZ, false, true, nullptr, drawPriority, nullptr, nullptr
+};
@@ -1,30 +1,46 @@
 #include "ScreenBattery.h"
 
 #include "UiDraw.h"
+#include "UiFormat.h"
 #include "UiLayout.h"
-#include "UiStrings.h"
 
-void ScreenBattery_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  UiDrawListHeader(renderer, "BATTERY & POWER");
-  char buf[10];
-  if (state.rxVoltageAvailable) {
-    snprintf(buf, sizeof(buf), "R%.1f", state.rxVoltage);
-    renderer.drawTextRight(86, UiLayout::ContentY + 3, buf, 1, TEXT_MUTED);
-  }
-  snprintf(buf, sizeof(buf), "T%.1f", state.txVoltage);
-  renderer.drawTextRight(124, UiLayout::ContentY + 3, buf, 1, TEXT_PRIMARY);
+namespace {
+// Warning thresholds are edited in 0.1 V steps as integer tenths.
+template <float UiState::*field>
+int32_t tenthsGet(const UiState &state) {
+  float scaled = state.*field * 10.0f;
+  return static_cast<int32_t>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+
+template <float UiState::*field>
+void tenthsSet(UiState &state, int32_t value) {
+  state.*field = value / 10.0f;
+}
 
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_BATTERY];
-  static const char *labels[] = {"TX WARN", "RX WARN", "SAG DETECT"};
-  char val[8];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 3) break;
-    const char *value = "";
-    if (idx == 0) { snprintf(val, sizeof(val), "%.1f", state.txVoltageWarn); value = val; }
-    else if (idx == 1) { snprintf(val, sizeof(val), "%.1f", state.rxVoltageWarn); value = val; }
-    else if (idx == 2) value = UiStrings::onOffLabel(state.voltageSagDetect);
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_BATTERY], ctx.editMode[SCREEN_BATTERY]);
+const char *fmtTenths(const UiItem &, const UiState &, int32_t value, char *buf, size_t size) {
+  UiFormat::decimal(buf, size, value, 1);
+  return buf;
+}
+
+void drawVoltages(Renderer &renderer, const UiState &state, const UiContext &) {
+  static UiFormat::Field rxField;
+  static UiFormat::Field txField;
+  if (!UiDrawDynamic()) return;
+  if (state.rxVoltageAvailable) {
+    renderer.drawTextRight(86, UiLayout::ContentY + 3, rxField.fixed(state.rxVoltage, 1, "R"), 1, TEXT_MUTED);
   }
+  renderer.drawTextRight(124, UiLayout::ContentY + 3, txField.fixed(state.txVoltage, 1, "T"), 1, TEXT_PRIMARY);
 }
+
+constexpr UiItem kItems[] = {
+  UiItemRange("TX WARN", tenthsGet<&UiState::txVoltageWarn>, tenthsSet<&UiState::txVoltageWarn>, 60, 84, 1,
+              nullptr, fmtTenths),
+  UiItemRange("RX WARN", tenthsGet<&UiState::rxVoltageWarn>, tenthsSet<&UiState::rxVoltageWarn>, 58, 76, 1,
+              nullptr, fmtTenths),
+  UiItemToggle("SAG DETECT", UI_FIELD(voltageSagDetect)),
+};
+}  // namespace
+
+const UiScreenDesc ScreenBattery_Desc = {
+  "BATTERY & POWER", kItems, UI_ITEM_COUNT(kItems), UI_DEP_POWER | UI_DEP_SETTINGS, UI_REFRESH_5HZ, false, true, nullptr, drawVoltages, nullptr, nullptr
+};
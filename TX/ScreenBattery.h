@@ -1,8 +1,5 @@
 #pragma once
 
-#include "Renderer.h"
-#include "UiState.h"
+#include "UiMenu.h"
 
-struct UiContext;
-
-void ScreenBattery_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx);
+extern const UiScreenDesc ScreenBattery_Desc;
@@ -1,13 +1,14 @@
 #include "ScreenCalibration.h"
 
+#include "UiFormat.h"
 #include "UiLayout.h"
 
-void ScreenCalibration_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
+void ScreenCalibration_Draw(Renderer &renderer, const UiState &state, const UiContext &) {
   renderer.fillRect(0, UiLayout::ContentY, UiLayout::ScreenW, UiLayout::ContentH, BG_PANEL);
   renderer.drawRect(0, UiLayout::ContentY, UiLayout::ScreenW, UiLayout::ContentH, GRID_LINE);
   renderer.drawText(6, UiLayout::ContentY + 4, "CALIBRATION", 1, TEXT_PRIMARY);
   char buf[12];
-  snprintf(buf, sizeof(buf), "STEP %u/3", state.wizardStep + 1);
+  UiFormat::unsignedInt(buf, sizeof(buf), state.wizardStep + 1, "STEP ", "/3");
   renderer.drawText(6, UiLayout::ContentY + 20, buf, 1, TEXT_MUTED);
 
   const char *msg = "CENTER STEER";
@@ -18,8 +19,12 @@ void ScreenCalibration_Draw(Renderer &renderer, const UiState &state, const UiCo
   renderer.drawText(6, UiLayout::ContentY + 54, "SET TO ADVANCE", 1, TEXT_MUTED);
 }
 
-void ScreenCalibration_HandleInput(const InputActions &actions, UiState &state, UiContext &ctx) {
+void ScreenCalibration_HandleInput(const InputActions &actions, UiState &state, UiContext &) {
   if (actions.setShort) {
     state.wizardStep = (state.wizardStep + 1) % 4;
   }
 }
+
+const UiScreenDesc ScreenCalibration_Desc = {
+  nullptr, nullptr, 0, UI_DEP_DIAG, UI_REFRESH_30HZ, false, false, ScreenCalibration_Draw, nullptr, ScreenCalibration_HandleInput, nullptr
+};
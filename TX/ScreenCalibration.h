@@ -1,10 +1,8 @@
 #pragma once
 
-#include "InputManager.h"
-#include "Renderer.h"
-#include "UiState.h"
-
-struct UiContext;
+#include "UiMenu.h"
 
 void ScreenCalibration_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx);
 void ScreenCalibration_HandleInput(const InputActions &actions, UiState &state, UiContext &ctx);
+
+extern const UiScreenDesc ScreenCalibration_Desc;
@@ -1,10 +1,14 @@
 #include "ScreenDashboard.h"
 
 #include "UiDraw.h"
+#include "UiFormat.h"
+#include "UiGauge.h"
 #include "UiLayout.h"
 #include "UiStrings.h"
 
 namespace {
+UiGauge throttleGauge(-100, 100, BG_PANEL_ALT);
+
 void drawCenterBar(Renderer &renderer, int16_t x, int16_t y, int16_t w, int16_t h, int16_t pct) {
   renderer.fillRect(x, y, w, h, BG_PANEL_ALT);
   renderer.drawRect(x, y, w, h, GRID_LINE);
@@ -22,7 +26,7 @@ void drawCenterBar(Renderer &renderer, int16_t x, int16_t y, int16_t w, int16_t
 }
 }  // namespace
 
-void ScreenDashboard_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
+void ScreenDashboard_Draw(Renderer &renderer, const UiState &state, const UiContext &) {
   int16_t y = UiLayout::ContentY;
 
   int16_t speedH = 40;
@@ -30,7 +34,7 @@ void ScreenDashboard_Draw(Renderer &renderer, const UiState &state, const UiCont
   renderer.drawRect(0, y, UiLayout::ScreenW, speedH, GRID_LINE);
   renderer.drawText(6, y + 4, "SPEED", 1, TEXT_MUTED);
   char buf[8];
-  snprintf(buf, sizeof(buf), "%d", static_cast<int>(state.speedKmh));
+  UiFormat::integer(buf, sizeof(buf), static_cast<int>(state.speedKmh));
   renderer.drawTextRight(110, y + 8, buf, 3, TEXT_PRIMARY);
   renderer.drawTextRight(124, y + 22, "KMH", 1, TEXT_MUTED);
 
@@ -38,11 +42,14 @@ void ScreenDashboard_Draw(Renderer &renderer, const UiState &state, const UiCont
   int16_t ctlH = 46;
   renderer.fillRect(0, y, UiLayout::ScreenW, ctlH, BG_PANEL_ALT);
   renderer.drawRect(0, y, UiLayout::ScreenW, ctlH, GRID_LINE);
-  renderer.drawText(6, y + 4, "THROTTLE", 1, TEXT_MUTED);
-  drawCenterBar(renderer, 58, y + 6, 66, 10, static_cast<int>(state.throttlePct));
+  int16_t throttle = static_cast<int16_t>(state.throttlePct);
+  throttleGauge.draw(renderer, 2, y + 1, throttle);
+  renderer.drawText(50, y + 4, "THROTTLE", 1, TEXT_MUTED);
+  UiFormat::integer(buf, sizeof(buf), throttle, nullptr, "%");
+  renderer.drawTextRight(124, y + 14, buf, 1, TEXT_PRIMARY);
 
-  renderer.drawText(6, y + 24, "STEER", 1, TEXT_MUTED);
-  drawCenterBar(renderer, 58, y + 26, 66, 10, static_cast<int>(state.steerPct));
+  renderer.drawText(50, y + 24, "STEER", 1, TEXT_MUTED);
+  drawCenterBar(renderer, 50, y + 33, 74, 9, static_cast<int>(state.steerPct));
 
   y += ctlH;
   int16_t auxH = UiLayout::ScreenH - y;
@@ -63,3 +70,7 @@ void ScreenDashboard_Draw(Renderer &renderer, const UiState &state, const UiCont
   renderer.drawText(28, y + 36, "SIG", 1, TEXT_MUTED);
   renderer.drawText(64, y + 36, UiStrings::turnLabel(state.turnSignals), 1, TEXT_PRIMARY);
 }
+
+const UiScreenDesc ScreenDashboard_Desc = {
+  nullptr, nullptr, 0, UI_DEP_CONTROLS | UI_DEP_GYRO | UI_DEP_SETTINGS, UI_REFRESH_60HZ, false, false, ScreenDashboard_Draw, nullptr, nullptr, nullptr
+};
@@ -1,8 +1,7 @@
 #pragma once
 
-#include "Renderer.h"
-#include "UiState.h"
-
-struct UiContext;
+#include "UiMenu.h"
 
 void ScreenDashboard_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx);
+
+extern const UiScreenDesc ScreenDashboard_Desc;
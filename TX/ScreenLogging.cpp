@@ -1,22 +1,18 @@
 #include "ScreenLogging.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
-
-void ScreenLogging_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"PEAK TEMP", "MAX SPEED", "DRIVE TIME", "ERRORS"};
-  UiDrawListHeader(renderer, "LOGGING");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_LOGGING];
-  char buf[12];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    const char *value = "";
-    if (idx == 0) { snprintf(buf, sizeof(buf), "%uC", state.peakTemp); value = buf; }
-    else if (idx == 1) { snprintf(buf, sizeof(buf), "%u", state.maxSpeed); value = buf; }
-    else if (idx == 2) { snprintf(buf, sizeof(buf), "%lum", static_cast<unsigned long>(state.driveTimeSec / 60)); value = buf; }
-    else if (idx == 3) { snprintf(buf, sizeof(buf), "%u", state.errorCount); value = buf; }
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_LOGGING], ctx.editMode[SCREEN_LOGGING]);
-  }
+namespace {
+int32_t driveMinutes(const UiState &state) {
+  return static_cast<int32_t>(state.driveTimeSec / 60);
 }
+
+constexpr UiItem kItems[] = {
+  UiItemValue("PEAK TEMP", UI_GET(peakTemp), UiFmtInt, "C"),
+  UiItemValue("MAX SPEED", UI_GET(maxSpeed)),
+  UiItemValue("DRIVE TIME", driveMinutes, UiFmtInt, "m"),
+  UiItemValue("ERRORS", UI_GET(errorCount)),
+};
+}  // namespace
+
+const UiScreenDesc ScreenLogging_Desc = {
+  "LOGGING", kItems, UI_ITEM_COUNT(kItems), UI_DEP_LOG, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
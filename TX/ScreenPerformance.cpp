@@ -1,22 +1,30 @@
 #include "ScreenPerformance.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
+#include "UiFormat.h"
 
-void ScreenPerformance_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"LOOP US", "FPS", "CPU", "MEM"};
-  UiDrawListHeader(renderer, "PERFORMANCE");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_PERF];
-  char buf[12];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    const char *value = "";
-    if (idx == 0) { snprintf(buf, sizeof(buf), "%lu", static_cast<unsigned long>(state.loopTimeUs)); value = buf; }
-    else if (idx == 1) { snprintf(buf, sizeof(buf), "%u", state.fps); value = buf; }
-    else if (idx == 2) { snprintf(buf, sizeof(buf), "%u%%", state.cpuLoad); value = buf; }
-    else if (idx == 3) { snprintf(buf, sizeof(buf), "%lu", static_cast<unsigned long>(state.memFree)); value = buf; }
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_PERF], ctx.editMode[SCREEN_PERF]);
-  }
+namespace {
+int32_t textHitPercent(const UiState &state) {
+  uint32_t lookups = state.textCacheHits + state.textCacheMisses;
+  return lookups ? static_cast<int32_t>((state.textCacheHits * 100ULL) / lookups) : 0;
 }
+
+const char *fmtTextBytes(const UiItem &, const UiState &state, int32_t, char *buf, size_t size) {
+  size_t n = UiFormat::unsignedInt(buf, size, state.textCacheBytes, nullptr, "/");
+  UiFormat::unsignedInt(buf + n, size - n, state.textCacheSize);
+  return buf;
+}
+
+constexpr UiItem kItems[] = {
+  UiItemValue("LOOP US", UI_GET(loopTimeUs)),
+  UiItemValue("FPS", UI_GET(fps)),
+  UiItemValue("CPU", UI_GET(cpuLoad), UiFmtInt, "%"),
+  UiItemValue("MEM", UI_GET(memFree)),
+  UiItemValue("TXT HIT", textHitPercent, UiFmtInt, "%"),
+  UiItemValue("TXT MISS", UI_GET(textCacheMisses)),
+  UiItemValue("TXT BYTES", nullptr, fmtTextBytes),
+};
+}  // namespace
+
+const UiScreenDesc ScreenPerformance_Desc = {
+  "PERFORMANCE", kItems, UI_ITEM_COUNT(kItems), UI_DEP_PERF, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
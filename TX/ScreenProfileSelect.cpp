@@ -1,18 +1,27 @@
 #include "ScreenProfileSelect.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
+namespace {
+template <uint8_t profile>
+int32_t isActive(const UiState &state) {
+  return state.activeProfile == profile;
+}
+
+const char *fmtActive(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return value ? "ACTIVE" : "";
+}
 
-void ScreenProfileSelect_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"PROFILE 1", "PROFILE 2", "PROFILE 3", "PROFILE 4"};
-  UiDrawListHeader(renderer, "PROFILE SELECT");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_PROFILE_SELECT];
-  char buf[8];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    snprintf(buf, sizeof(buf), "%s", idx == state.activeProfile ? "ACTIVE" : "");
-    UiDrawListRow(renderer, row, labels[idx], buf, idx == ctx.focus[SCREEN_PROFILE_SELECT], ctx.editMode[SCREEN_PROFILE_SELECT]);
-  }
+void selectProfile(UiState &state, UiContext &, uint8_t index) {
+  state.activeProfile = index;
 }
+
+constexpr UiItem kItems[] = {
+  UiItemAction("PROFILE 1", selectProfile, isActive<0>, fmtActive),
+  UiItemAction("PROFILE 2", selectProfile, isActive<1>, fmtActive),
+  UiItemAction("PROFILE 3", selectProfile, isActive<2>, fmtActive),
+  UiItemAction("PROFILE 4", selectProfile, isActive<3>, fmtActive),
+};
+}  // namespace
+
+const UiScreenDesc ScreenProfileSelect_Desc = {
+  "PROFILE SELECT", kItems, UI_ITEM_COUNT(kItems), UI_DEP_SETTINGS, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
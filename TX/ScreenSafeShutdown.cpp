@@ -1,16 +1,17 @@
 #include "ScreenSafeShutdown.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
+namespace {
+// Placeholder for safe actions.
+void holdAction(UiState &, UiContext &, uint8_t) {}
 
-void ScreenSafeShutdown_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"SAFE STATE", "OUTPUT DISABLE", "SAVE & OFF", "REBOOT"};
-  UiDrawListHeader(renderer, "SAFE SHUTDOWN");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_SAFE_SHUTDOWN];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    UiDrawListRow(renderer, row, labels[idx], "", idx == ctx.focus[SCREEN_SAFE_SHUTDOWN], ctx.editMode[SCREEN_SAFE_SHUTDOWN]);
-  }
-}
+constexpr UiItem kItems[] = {
+  UiItemAction("SAFE STATE", holdAction),
+  UiItemAction("OUTPUT DISABLE", holdAction),
+  UiItemAction("SAVE & OFF", holdAction),
+  UiItemAction("REBOOT", holdAction),
+};
+}  // namespace
+
+const UiScreenDesc ScreenSafeShutdown_Desc = {
+  "SAFE SHUTDOWN", kItems, UI_ITEM_COUNT(kItems), 0, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
@@ -1,22 +1,14 @@
 #include "ScreenSteering.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
+namespace {
+constexpr UiItem kItems[] = {
+  UiItemRange("DEADZONE", UI_FIELD(steerDeadzone), 0, 20),
+  UiItemRange("CENTER", UI_FIELD(steerCenter), -20, 20),
+  UiItemRange("EXPO", UI_FIELD(steerExpo), 0, 50),
+  UiItemRange("ENDPTS", UI_FIELD(steerEndpoint), 80, 120),
+};
+}  // namespace
 
-void ScreenSteering_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"DEADZONE", "CENTER", "EXPO", "ENDPTS"};
-  UiDrawListHeader(renderer, "STEERING SETUP");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_STEERING];
-  char buf[8];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    const char *value = "";
-    if (idx == 0) { snprintf(buf, sizeof(buf), "%u", state.steerDeadzone); value = buf; }
-    else if (idx == 1) { snprintf(buf, sizeof(buf), "%d", state.steerCenter); value = buf; }
-    else if (idx == 2) { snprintf(buf, sizeof(buf), "%u", state.steerExpo); value = buf; }
-    else if (idx == 3) { snprintf(buf, sizeof(buf), "%u", state.steerEndpoint); value = buf; }
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_STEERING], ctx.editMode[SCREEN_STEERING]);
-  }
-}
+const UiScreenDesc ScreenSteering_Desc = {
+  "STEERING SETUP", kItems, UI_ITEM_COUNT(kItems), UI_DEP_SETTINGS, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
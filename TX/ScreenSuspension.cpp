@@ -1,23 +1,24 @@
 #include "ScreenSuspension.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
 #include "UiStrings.h"
 
-void ScreenSuspension_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"MODE", "POT MAP", "SPEED LOGIC", "PRESET"};
-  UiDrawListHeader(renderer, "SUSPENSION");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_SUSPENSION];
-  char buf[8];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    const char *value = "";
-    if (idx == 0) value = UiStrings::suspModeLabel(state.suspensionMode);
-    else if (idx == 1) { snprintf(buf, sizeof(buf), "%u", state.suspensionPotMap); value = buf; }
-    else if (idx == 2) { snprintf(buf, sizeof(buf), "%u", state.suspensionSpeedLogic); value = buf; }
-    else if (idx == 3) value = UiStrings::suspPresetLabel(state.suspensionPreset);
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_SUSPENSION], ctx.editMode[SCREEN_SUSPENSION]);
-  }
+namespace {
+const char *fmtMode(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::suspModeLabel(static_cast<SuspensionMode>(value));
 }
+
+const char *fmtPreset(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::suspPresetLabel(static_cast<SuspensionPreset>(value));
+}
+
+constexpr UiItem kItems[] = {
+  UiItemCycle("MODE", UI_FIELD(suspensionMode), 2, fmtMode),
+  UiItemRange("POT MAP", UI_FIELD(suspensionPotMap), 0, 100, 2),
+  UiItemRange("SPEED LOGIC", UI_FIELD(suspensionSpeedLogic), 0, 100, 2),
+  UiItemCycle("PRESET", UI_FIELD(suspensionPreset), 3, fmtPreset),
+};
+}  // namespace
+
+const UiScreenDesc ScreenSuspension_Desc = {
+  "SUSPENSION", kItems, UI_ITEM_COUNT(kItems), UI_DEP_SETTINGS, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
@@ -1,23 +1,24 @@
 #include "ScreenSystem.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
 #include "UiStrings.h"
 
-void ScreenSystem_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"BRIGHTNESS", "SLEEP", "LED", "BOOT"};
-  UiDrawListHeader(renderer, "SYSTEM");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_SYSTEM];
-  char buf[8];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    const char *value = "";
-    if (idx == 0) { snprintf(buf, sizeof(buf), "%u", state.displayBrightness); value = buf; }
-    else if (idx == 1) { snprintf(buf, sizeof(buf), "%us", state.sleepTimeoutSec); value = buf; }
-    else if (idx == 2) value = UiStrings::ledModeLabel(state.ledMode);
-    else if (idx == 3) value = UiStrings::bootModeLabel(state.bootMode);
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_SYSTEM], ctx.editMode[SCREEN_SYSTEM]);
-  }
+namespace {
+const char *fmtLed(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::ledModeLabel(static_cast<LedMode>(value));
 }
+
+const char *fmtBoot(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::bootModeLabel(static_cast<BootMode>(value));
+}
+
+constexpr UiItem kItems[] = {
+  UiItemRange("BRIGHTNESS", UI_FIELD(displayBrightness), 10, 100, 5),
+  UiItemRange("SLEEP", UI_FIELD(sleepTimeoutSec), 60, 900, 30, "s"),
+  UiItemCycle("LED", UI_FIELD(ledMode), 3, fmtLed),
+  UiItemCycle("BOOT", UI_FIELD(bootMode), 2, fmtBoot),
+};
+}  // namespace
+
+const UiScreenDesc ScreenSystem_Desc = {
+  "SYSTEM", kItems, UI_ITEM_COUNT(kItems), UI_DEP_SETTINGS, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
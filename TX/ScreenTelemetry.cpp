@@ -2,48 +2,81 @@
 
 #include "UiDraw.h"
 #include "UiLayout.h"
+#include "UiSparkline.h"
 
-void ScreenTelemetry_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  UiDrawListHeader(renderer, "EXT TELEMETRY");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_TELEMETRY];
-  char buf[12];
+namespace {
+constexpr UiItem kItems[] = {
+  UiItemValue("MOTOR TEMP", UI_GET(tempMotor), UiFmtInt, "C"),
+  UiItemValue("ESC TEMP", UI_GET(tempEsc), UiFmtInt, "C"),
+  UiItemValue("BOARD TEMP", UI_GET(tempBoard), UiFmtInt, "C"),
+  UiItemValue("RPM EST", UI_GET(rpmEstimate)),
+  UiItemValue("CURRENT", UI_GET(currentA), UiFmtInt, "A"),
+  UiItemValue("SIGNAL", UI_GET(signalStrength), UiFmtInt, "%"),
+  UiItemValue("LATENCY", UI_GET(latencyMs), UiFmtInt, "MS"),
+};
+
+const int16_t kTraceH = 40;
+
+UiSparkline throttleTrace(-100, 100, ACCENT_CYAN, BG_PRIMARY);
+UiSparkline currentTrace(0, 60, ACCENT_AMBER, BG_PRIMARY);
+UiSparkline signalTrace(0, 100, STATE_OK, BG_PRIMARY);
+
+struct Trace {
+  const char *label;
+  UiSparkline *graph;
+  UiItem item;
+};
 
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 7) break;
-    const char *label = "";
-    const char *value = "";
-    if (idx == 0) {
-      label = "MOTOR TEMP";
-      snprintf(buf, sizeof(buf), "%dC", static_cast<int>(state.tempMotor));
-      value = buf;
-    } else if (idx == 1) {
-      label = "ESC TEMP";
-      snprintf(buf, sizeof(buf), "%dC", static_cast<int>(state.tempEsc));
-      value = buf;
-    } else if (idx == 2) {
-      label = "BOARD TEMP";
-      snprintf(buf, sizeof(buf), "%dC", static_cast<int>(state.tempBoard));
-      value = buf;
-    } else if (idx == 3) {
-      label = "RPM EST";
-      snprintf(buf, sizeof(buf), "%d", static_cast<int>(state.rpmEstimate));
-      value = buf;
-    } else if (idx == 4) {
-      label = "CURRENT";
-      snprintf(buf, sizeof(buf), "%dA", static_cast<int>(state.currentA));
-      value = buf;
-    } else if (idx == 5) {
-      label = "SIGNAL";
-      snprintf(buf, sizeof(buf), "%d%%", static_cast<int>(state.signalStrength));
-      value = buf;
-    } else if (idx == 6) {
-      label = "LATENCY";
-      snprintf(buf, sizeof(buf), "%dMS", static_cast<int>(state.latencyMs));
-      value = buf;
+const Trace kTraces[] = {
+  {"THROTTLE", &throttleTrace, UiItemValue(nullptr, UI_GET(throttlePct), UiFmtInt, "%")},
+  {"CURRENT", &currentTrace, kItems[4]},
+  {"SIGNAL", &signalTrace, kItems[5]},
+};
+
+void drawTraces(Renderer &renderer, const UiState &state) {
+  UiDrawListHeader(renderer, "LIVE TRACES");
+  char buf[12];
+  for (uint8_t i = 0; i < sizeof(kTraces) / sizeof(kTraces[0]); ++i) {
+    const Trace &trace = kTraces[i];
+    int16_t y = UiLayout::ListY + (i * kTraceH);
+    if (UiDrawStatic()) {
+      renderer.fillRect(0, y, UiLayout::ScreenW, kTraceH, (i % 2 == 0) ? BG_PANEL : BG_PANEL_ALT);
+      renderer.drawRect(0, y, UiLayout::ScreenW, kTraceH, GRID_LINE);
+      renderer.drawText(6, y + 4, trace.label, 1, TEXT_PRIMARY);
+    }
+    if (UiDrawDynamic()) {
+      const UiItem &item = trace.item;
+      renderer.drawTextRight(124, y + 4, item.format(item, state, item.get(state), buf, sizeof(buf)), 1,
+                             TEXT_MUTED);
+      trace.graph->draw(renderer, 6, y + 14);
     }
-    bool focused = (idx == ctx.focus[SCREEN_TELEMETRY]);
-    UiDrawListRow(renderer, row, label, value, focused, ctx.editMode[SCREEN_TELEMETRY]);
   }
 }
+
+// SET toggles edit mode, which on this read-only list switches between
+// the numbers and the traces.
+void drawTelemetry(Renderer &renderer, const UiState &state, const UiContext &ctx) {
+  if (ctx.editMode[SCREEN_TELEMETRY]) {
+    drawTraces(renderer, state);
+  } else {
+    UiMenuDrawList(renderer, SCREEN_TELEMETRY, ScreenTelemetry_Desc, state, ctx);
+  }
+}
+
+bool tracesLive(const UiContext &ctx) {
+  return ctx.editMode[SCREEN_TELEMETRY] &&
+         (throttleTrace.moving() || currentTrace.moving() || signalTrace.moving());
+}
+}  // namespace
+
+// Traces sample on every loop pass, on any screen, so they have history
+// to show the moment they are opened.
+void ScreenTelemetry_Sample(const UiState &state, uint32_t nowMs) {
+  throttleTrace.sample(static_cast<int16_t>(state.throttlePct), nowMs);
+  currentTrace.sample(static_cast<int16_t>(state.currentA), nowMs);
+  signalTrace.sample(static_cast<int16_t>(state.signalStrength), nowMs);
+}
+
+const UiScreenDesc ScreenTelemetry_Desc = {
+  "EXT TELEMETRY", kItems, UI_ITEM_COUNT(kItems), UI_DEP_CONTROLS | UI_DEP_TEMPS | UI_DEP_TELEMETRY, UI_REFRESH_10HZ, false, true, drawTelemetry, nullptr, nullptr, tracesLive
+};
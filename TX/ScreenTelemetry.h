@@ -1,8 +1,7 @@
 #pragma once
 
-#include "Renderer.h"
-#include "UiState.h"
+#include "UiMenu.h"
 
-struct UiContext;
-
-void ScreenTelemetry_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx);
+extern const UiScreenDesc ScreenTelemetry_Desc;
+// Feeds the live traces; called from the state update, not from drawing.
+void ScreenTelemetry_Sample(const UiState &state, uint32_t nowMs);
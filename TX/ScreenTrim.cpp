@@ -1,23 +1,19 @@
 #include "ScreenTrim.h"
 
-#include "UiDraw.h"
-#include "UiLayout.h"
-#include "UiStrings.h"
-
-void ScreenTrim_Draw(Renderer &renderer, const UiState &state, const UiContext &ctx) {
-  static const char *labels[] = {"STEER TRIM", "THR TRIM", "RESET", "PER PROFILE"};
-  UiDrawListHeader(renderer, "TRIM MANAGEMENT");
-  int visible = UiLayout::ListH / UiLayout::ItemH;
-  int start = ctx.scroll[SCREEN_TRIM];
-  char buf[8];
-  for (int row = 0; row < visible; ++row) {
-    int idx = start + row;
-    if (idx >= 4) break;
-    const char *value = "";
-    if (idx == 0) { snprintf(buf, sizeof(buf), "%d", state.steerTrim); value = buf; }
-    else if (idx == 1) { snprintf(buf, sizeof(buf), "%d", state.throttleTrim); value = buf; }
-    else if (idx == 2) value = "HOLD SET";
-    else if (idx == 3) value = UiStrings::onOffLabel(state.trimPerProfile);
-    UiDrawListRow(renderer, row, labels[idx], value, idx == ctx.focus[SCREEN_TRIM], ctx.editMode[SCREEN_TRIM]);
-  }
+namespace {
+void resetTrims(UiState &state, UiContext &, uint8_t) {
+  state.steerTrim = 0;
+  state.throttleTrim = 0;
 }
+
+constexpr UiItem kItems[] = {
+  UiItemRange("STEER TRIM", UI_FIELD(steerTrim), -20, 20),
+  UiItemRange("THR TRIM", UI_FIELD(throttleTrim), -20, 20),
+  UiItemAction("RESET", resetTrims, nullptr, UiFmtText, "HOLD SET"),
+  UiItemToggle("PER PROFILE", UI_FIELD(trimPerProfile)),
+};
+}  // namespace
+
+const UiScreenDesc ScreenTrim_Desc = {
+  "TRIM MANAGEMENT", kItems, UI_ITEM_COUNT(kItems), UI_DEP_SETTINGS, UI_REFRESH_5HZ, false, true, nullptr, nullptr, nullptr, nullptr
+};
@@ -4,6 +4,8 @@
 #include <math.h>
 
 #include "HardwareConfig.h"
+#include "DisplayList.h"
+#include "FlushPlanner.h"
 #include "PanelIO.h"
 #include "Palette.h"
 #include "Renderer.h"
@@ -11,73 +13,639 @@
 #include "UiState.h"
 #include "Ui.h"
 #include "Buzzer.h"
+#include "FrameMirror.h"
+#include "FrameScheduler.h"
+#include "Overdraw.h"
+#include "PerfBench.h"
+#include "TextCache.h"
+#include "UiLayout.h"
+
+// Modes that keep one framebuffer which the panel mirrors.
+#if FRAME_TILE_HASH || FRAME_DISPLAY_LIST
+#define FRAME_SINGLE_BUFFER 1
+#else
+#define FRAME_SINGLE_BUFFER 0
+#endif
+
+// Hardware scroll rotates the front buffer along with the panel, so it
+// needs the front/back diff.
+#if FRAME_HW_SCROLL && !FRAME_SINGLE_BUFFER && !FRAME_BAND_ROWS
+#define FRAME_SCROLL_ACTIVE 1
+#else
+#define FRAME_SCROLL_ACTIVE 0
+#endif
 
 static Palette palette;
 static Renderer renderer;
+static TextCache textCache;
 static InputManager input;
 static UiManager ui;
+static FrameScheduler scheduler;
 static Buzzer buzzer;
 static Preferences prefs;
 
 static UiState state;
 
-static uint16_t *frameA = nullptr;
-static uint16_t *frameB = nullptr;
-static uint16_t *frontBuffer = nullptr;
-static uint16_t *backBuffer = nullptr;
+static FramePixel *frontBuffer = nullptr;
+static FramePixel *backBuffer = nullptr;
 
 static const int16_t kWidth = PanelIO::kWidth;
 static const int16_t kHeight = PanelIO::kHeight;
-static const int16_t kTileW = 16;
-static const int16_t kTileH = 16;
+static const int16_t kTileW = Renderer::kTileW;
+static const int16_t kTileH = Renderer::kTileH;
+static const uint16_t kTileCount = ((kWidth + kTileW - 1) / kTileW) * ((kHeight + kTileH - 1) / kTileH);
+static_assert(kTileCount <= Renderer::kMaxTiles && kTileCount <= FlushPlanner::kMaxTiles,
+              "FRAME_TILE_W/FRAME_TILE_H split the screen into too many tiles");
+static_assert((kWidth + kTileW - 1) / kTileW <= FlushPlanner::kMaxTilesX, "FRAME_TILE_W leaves too many tiles per row");
+
+static FlushPlanner planner;
+// Two rect lists: one may still be streaming while the next frame plans.
+static FlushRect flushRectLists[2][kTileCount];
+static FlushRect *flushRects = flushRectLists[0];
+static uint16_t flushRectCount = 0;
+static bool framePending = false;
+
+#if FRAME_BAND_ROWS
+#if FRAME_TILE_HASH
+#error "FRAME_BAND_ROWS and FRAME_TILE_HASH are mutually exclusive"
+#endif
+static const int16_t kBandRows = FRAME_BAND_ROWS;
+static const int16_t kBandCount = (kHeight + kBandRows - 1) / kBandRows;
+// Two strips: one renders while the other is on the wire.
+static FramePixel *bandBuffers[2] = {nullptr, nullptr};
+static FlushRect bandRects[2];
+static uint8_t bandSlot = 0;
+static uint32_t bandHash[kBandCount];
+static bool bandHashValid = false;
+#endif
+
+#if FRAME_DISPLAY_LIST
+#if FRAME_TILE_HASH || FRAME_BAND_ROWS
+#error "FRAME_DISPLAY_LIST cannot be combined with FRAME_TILE_HASH or FRAME_BAND_ROWS"
+#endif
+// The list recorded this frame and the one it is diffed against.
+static DisplayList displayLists[2];
+static DisplayList *displayList = &displayLists[0];
+static bool displayListValid = false;
+#endif
+
+#if FRAME_MIRROR
+#if FRAME_BAND_ROWS
+#error "FRAME_MIRROR reads a full framebuffer and cannot be combined with FRAME_BAND_ROWS"
+#endif
+#if FRAME_STATS || SESSION_RECORD || RENDER_OVERDRAW
+#error "FRAME_MIRROR owns the serial port; turn off FRAME_STATS, SESSION_RECORD and RENDER_OVERDRAW"
+#endif
+static FrameMirror mirror;
+#endif
+
+#if RENDER_OVERDRAW
+static OverdrawMap overdraw;
+// Renderer writes per screen, summed over every frame drawn on it.
+struct OverdrawTotals {
+  uint32_t frames;
+  uint32_t writes;
+  uint32_t covered;
+  uint32_t regionPixels;
+  uint32_t kindWrites[OVERDRAW_KIND_COUNT];
+};
+static OverdrawTotals overdrawTotals[SCREEN_COUNT];
+static ScreenId overdrawScreen = SCREEN_BOOT;
+// The heatmap is printed at the first full frame after a screen change.
+static bool overdrawMapped = false;
+static uint16_t overdrawMaps = 0;
+#endif
+
+#if FRAME_TILE_HASH
+static uint32_t tileHash[Renderer::kMaxTiles];
+static bool tileHashValid = false;
+#if FRAME_TILE_HASH_VERIFY
+static FramePixel *shadowBuffer = nullptr;
+#endif
+#endif
+
+#if FRAME_SCROLL_ACTIVE
+// The visible list rows scroll; header, overlay and the rows below stay.
+static const int16_t kScrollTop = UiLayout::ListY;
+static const int16_t kScrollRows = (UiLayout::ListH / UiLayout::ItemH) * UiLayout::ItemH;
+static int16_t listScrollOffset = 0;
+static ScreenId scrollScreen = SCREEN_BOOT;
+static bool frontScrolled = false;
+#endif
+
+struct FlushStats {
+  uint32_t tilesChecked = 0;
+  uint32_t tilesPushed = 0;
+  uint32_t rectsPushed = 0;
+  uint32_t pixelsPushed = 0;
+  uint32_t checkCycles = 0;
+  uint32_t hashMatches = 0;
+  uint32_t collisions = 0;
+  uint32_t framesDeferred = 0;
+  uint32_t commandsRecorded = 0;
+  uint32_t commandsChanged = 0;
+  uint32_t pixelsRasterized = 0;
+  uint32_t framesRendered = 0;
+  uint32_t framesSkipped = 0;
+  uint32_t renderUs = 0;
+  uint32_t scrolls = 0;
+};
+static FlushStats flushStats;
+#if FRAME_INDEXED
+static uint16_t paletteRevision = 0;
+#endif
 
-static uint32_t lastFrameMs = 0;
 static uint32_t lastFpsMs = 0;
 static uint16_t frameCount = 0;
 static uint32_t lastSimMs = 0;
 static uint32_t lastDriveMs = 0;
 
 static void allocateBuffers() {
-  size_t bufSize = static_cast<size_t>(kWidth) * kHeight * sizeof(uint16_t);
-  frameA = static_cast<uint16_t *>(heap_caps_malloc(bufSize, MALLOC_CAP_DMA));
-  frameB = static_cast<uint16_t *>(heap_caps_malloc(bufSize, MALLOC_CAP_DMA));
+#if FRAME_BAND_ROWS
+  size_t bandSize = static_cast<size_t>(kWidth) * kBandRows * sizeof(FramePixel);
+  bandBuffers[0] = static_cast<FramePixel *>(heap_caps_malloc(bandSize, MALLOC_CAP_DMA));
+  bandBuffers[1] = static_cast<FramePixel *>(heap_caps_malloc(bandSize, MALLOC_CAP_DMA));
+  if (!bandBuffers[0] || !bandBuffers[1]) {
+    Serial.println("Band buffer allocation failed");
+    while (true) { delay(100); }
+  }
+#else
+  size_t bufSize = static_cast<size_t>(kWidth) * kHeight * sizeof(FramePixel);
+  FramePixel *frameA = static_cast<FramePixel *>(heap_caps_malloc(bufSize, MALLOC_CAP_DMA));
+#if FRAME_SINGLE_BUFFER
+  if (!frameA) {
+    Serial.println("Frame buffer allocation failed");
+    while (true) { delay(100); }
+  }
+  frontBuffer = nullptr;
+  backBuffer = frameA;
+#if FRAME_TILE_HASH && FRAME_TILE_HASH_VERIFY
+  shadowBuffer = static_cast<FramePixel *>(malloc(bufSize));
+#endif
+#else
+  FramePixel *frameB = static_cast<FramePixel *>(heap_caps_malloc(bufSize, MALLOC_CAP_DMA));
   if (!frameA || !frameB) {
     Serial.println("Frame buffer allocation failed");
     while (true) { delay(100); }
   }
   frontBuffer = frameA;
   backBuffer = frameB;
+#endif
+#endif
 }
 
-static void flushDirtyTiles() {
-  const int tilesX = (kWidth + kTileW - 1) / kTileW;
-  const int tilesY = (kHeight + kTileH - 1) / kTileH;
+#if FRAME_TILE_HASH || FRAME_BAND_ROWS
+// Murmur3-style mix over 32-bit words; each tile row is hashed in place.
+static uint32_t hashTile(const FramePixel *pixels, int w, int h) {
+  const int rowBytes = w * sizeof(FramePixel);
+  uint32_t hash = 0x811C9DC5;
+  for (int yy = 0; yy < h; ++yy) {
+    const uint8_t *row = reinterpret_cast<const uint8_t *>(pixels + yy * kWidth);
+    for (int b = 0; b < rowBytes; b += 4) {
+      uint32_t k = 0;
+      memcpy(&k, row + b, (rowBytes - b < 4) ? (rowBytes - b) : 4);
+      k *= 0xCC9E2D51;
+      k = (k << 15) | (k >> 17);
+      k *= 0x1B873593;
+      hash ^= k;
+      hash = (hash << 13) | (hash >> 19);
+      hash = hash * 5 + 0xE6546B64;
+    }
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6B;
+  hash ^= hash >> 13;
+  return hash;
+}
+#endif
+
+// Band and display-list frames find their changes without the tile diff.
+#if !FRAME_BAND_ROWS && !FRAME_DISPLAY_LIST
+#if FRAME_TILE_HASH
+static bool tileChanged(int tile, int x, int y, int w, int h) {
+  const FramePixel *origin = backBuffer + y * kWidth + x;
+  uint32_t hash = hashTile(origin, w, h);
+  bool changed = !tileHashValid || hash != tileHash[tile];
+  tileHash[tile] = hash;
+
+#if FRAME_TILE_HASH_VERIFY
+  if (shadowBuffer) {
+    bool differs = false;
+    for (int yy = 0; yy < h; ++yy) {
+      int idx = (y + yy) * kWidth + x;
+      if (memcmp(backBuffer + idx, shadowBuffer + idx, w * sizeof(FramePixel)) != 0) differs = true;
+      memcpy(shadowBuffer + idx, backBuffer + idx, w * sizeof(FramePixel));
+    }
+    if (!changed && tileHashValid) {
+      flushStats.hashMatches++;
+      if (differs) {
+        flushStats.collisions++;
+        changed = true;
+      }
+    }
+  }
+#else
+  if (!changed) flushStats.hashMatches++;
+#endif
+  return changed;
+}
+#else
+static bool tileChanged(int, int x, int y, int w, int h) {
+  for (int yy = 0; yy < h; ++yy) {
+    int idx = (y + yy) * kWidth + x;
+    if (memcmp(backBuffer + idx, frontBuffer + idx, w * sizeof(FramePixel)) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+#endif
+
+// Compares the tiles overlapping rows [top, bottom) against the panel.
+static void flushDirtyTiles(int16_t top, int16_t bottom) {
+  const int tilesX = renderer.tilesX();
+  planner.reset();
+  flushRects = (flushRects == flushRectLists[0]) ? flushRectLists[1] : flushRectLists[0];
+
+#if FRAME_INDEXED
+  // Indices do not change when the palette does, so a new palette
+  // revision pushes every tile once.
+  if (palette.revision() != paletteRevision) {
+    paletteRevision = palette.revision();
+    for (int ty = 0; ty < renderer.tilesY(); ++ty) {
+      for (int tx = 0; tx < tilesX; ++tx) {
+        planner.markTile(tx, ty);
+      }
+    }
+  }
+#endif
 
-  for (int ty = 0; ty < tilesY; ++ty) {
+  const int tyEnd = (bottom + kTileH - 1) / kTileH;
+  for (int ty = top / kTileH; ty < tyEnd; ++ty) {
     for (int tx = 0; tx < tilesX; ++tx) {
+#if FRAME_TILE_HASH
+      if (tileHashValid && !renderer.tileMayDiffer(tx, ty)) continue;
+#elif FRAME_SCROLL_ACTIVE
+      bool inScroll = frontScrolled && (ty + 1) * kTileH > kScrollTop && ty * kTileH < kScrollTop + kScrollRows;
+      if (!inScroll && !renderer.tileMayDiffer(tx, ty)) continue;
+#else
+      if (!renderer.tileMayDiffer(tx, ty)) continue;
+#endif
+
       int x = tx * kTileW;
       int y = ty * kTileH;
       int w = (x + kTileW <= kWidth) ? kTileW : (kWidth - x);
       int h = (y + kTileH <= kHeight) ? kTileH : (kHeight - y);
 
-      bool dirty = false;
-      for (int yy = 0; yy < h && !dirty; ++yy) {
-        int idx = (y + yy) * kWidth + x;
-        for (int xx = 0; xx < w; ++xx) {
-          if (backBuffer[idx + xx] != frontBuffer[idx + xx]) {
-            dirty = true;
-            break;
-          }
-        }
-      }
+      uint32_t start = ESP.getCycleCount();
+      bool dirty = tileChanged(ty * tilesX + tx, x, y, w, h);
+      flushStats.checkCycles += ESP.getCycleCount() - start;
+      flushStats.tilesChecked++;
 
       if (dirty) {
-        PanelIO::pushRectDMA(x, y, w, h, backBuffer, kWidth);
+        flushStats.tilesPushed++;
+        planner.markTile(tx, ty);
       }
     }
   }
+#if FRAME_TILE_HASH
+  tileHashValid = true;
+#endif
+#if FRAME_SCROLL_ACTIVE
+  frontScrolled = false;
+#endif
+
+  flushRectCount = planner.plan(flushRects, kTileCount);
+  for (uint16_t i = 0; i < flushRectCount; ++i) {
+    flushStats.pixelsPushed += static_cast<uint32_t>(flushRects[i].w) * flushRects[i].h;
+  }
+  flushStats.rectsPushed += flushRectCount;
+  framePending = true;
+}
+#endif
+
+// Buffer ownership: PanelIO owns the buffer it is streaming until
+// flushBusy() returns false. A planned frame waits in framePending until
+// the panel is free and only then becomes the front buffer, so the back
+// buffer being drawn into is never the one on the wire.
+static void startPendingFlush() {
+  // flushBusy() also refills the SPI queue, so call it every pass.
+  bool busy = PanelIO::flushBusy();
+  if (!framePending || busy) return;
+#if FRAME_INDEXED
+  PanelIO::beginFlush(flushRects, flushRectCount, backBuffer, kWidth, palette.table());
+#else
+  PanelIO::beginFlush(flushRects, flushRectCount, backBuffer, kWidth);
+#endif
+  framePending = false;
+#if FRAME_MIRROR
+  mirror.markFrame(flushRects, flushRectCount);
+#endif
+
+#if !FRAME_SINGLE_BUFFER
+  FramePixel *tmp = frontBuffer;
+  frontBuffer = backBuffer;
+  backBuffer = tmp;
+#endif
+}
+
+#if FRAME_SCROLL_ACTIVE
+static void reverseRows(FramePixel *rows, int16_t count) {
+  FramePixel tmp[kWidth];
+  for (int16_t a = 0, b = count - 1; a < b; ++a, --b) {
+    memcpy(tmp, rows + a * kWidth, sizeof(tmp));
+    memcpy(rows + a * kWidth, rows + b * kWidth, sizeof(tmp));
+    memcpy(rows + b * kWidth, tmp, sizeof(tmp));
+  }
 }
 
+// Scrolls the panel by the rows the current list moved and rotates the
+// front buffer's scroll band the same way, so the diff against the next
+// frame only finds the rows that were newly exposed. A new screen starts
+// unscrolled, since it is redrawn anyway and split row runs cost windows.
+static void applyHardwareScroll() {
+  int16_t rows = ui.takeScrollRows() % kScrollRows;
+  if (ui.currentScreen() != scrollScreen) {
+    scrollScreen = ui.currentScreen();
+    rows = -listScrollOffset;
+  }
+  if (rows == 0) return;
+  if (rows < 0) rows += kScrollRows;
+  listScrollOffset = (listScrollOffset + rows) % kScrollRows;
+  PanelIO::scrollTo(listScrollOffset);
+
+  FramePixel *band = frontBuffer + kScrollTop * kWidth;
+  reverseRows(band, rows);
+  reverseRows(band + rows * kWidth, kScrollRows - rows);
+  reverseRows(band, kScrollRows);
+#if FRAME_MIRROR
+  mirror.markRect(0, kScrollTop, kWidth, kScrollRows);
+#endif
+  frontScrolled = true;
+  flushStats.scrolls++;
+}
+#endif
+
+static bool backBufferFree() {
+  if (framePending) return false;
+#if FRAME_SINGLE_BUFFER
+  // The only framebuffer is also the one being transmitted.
+  if (PanelIO::flushBusy()) return false;
+#endif
+  return true;
+}
+
+#if FRAME_DISPLAY_LIST
+static void markBoxTiles(const DrawCommand &cmd) {
+  int16_t x0 = (cmd.x < 0) ? 0 : cmd.x;
+  int16_t y0 = (cmd.y < 0) ? 0 : cmd.y;
+  int16_t x1 = (cmd.x + cmd.w > kWidth) ? kWidth : cmd.x + cmd.w;
+  int16_t y1 = (cmd.y + cmd.h > kHeight) ? kHeight : cmd.y + cmd.h;
+  if (x0 >= x1 || y0 >= y1) return;
+  for (int16_t ty = y0 / kTileH; ty <= (y1 - 1) / kTileH; ++ty) {
+    for (int16_t tx = x0 / kTileW; tx <= (x1 - 1) / kTileW; ++tx) {
+      planner.markTile(tx, ty);
+    }
+  }
+}
+
+// Records the draw pass instead of rasterizing it, then compares the list
+// with last frame's in paint order. Both the old and new bounds of every
+// command that changed become dirty, and only the planned rects are
+// rasterized again by replaying the commands that touch them.
+static void renderDisplayList() {
+  const DisplayList *prevList = displayList;
+  displayList = (displayList == &displayLists[0]) ? &displayLists[1] : &displayLists[0];
+  displayList->reset();
+  renderer.setBuffer(backBuffer, kWidth, kHeight, &palette);
+  renderer.setRecorder(displayList);
+  ui.draw(renderer, state);
+  renderer.setRecorder(nullptr);
+  flushStats.commandsRecorded += displayList->size();
+
+  planner.reset();
+  flushRects = (flushRects == flushRectLists[0]) ? flushRectLists[1] : flushRectLists[0];
+
+  bool full = !displayListValid || displayList->overflowed();
+#if FRAME_INDEXED
+  if (palette.revision() != paletteRevision) {
+    paletteRevision = palette.revision();
+    full = true;
+  }
+#endif
+  if (full) {
+    for (int ty = 0; ty < renderer.tilesY(); ++ty) {
+      for (int tx = 0; tx < renderer.tilesX(); ++tx) {
+        planner.markTile(tx, ty);
+      }
+    }
+  } else {
+    uint16_t n = (displayList->size() > prevList->size()) ? displayList->size() : prevList->size();
+    for (uint16_t i = 0; i < n; ++i) {
+      if (displayList->matches(i, *prevList)) continue;
+      flushStats.commandsChanged++;
+      if (i < displayList->size()) markBoxTiles(displayList->at(i));
+      if (i < prevList->size()) markBoxTiles(prevList->at(i));
+    }
+  }
+
+  flushRectCount = planner.plan(flushRects, kTileCount);
+  if (displayList->overflowed()) {
+    // The list is incomplete; draw the frame directly instead.
+    ui.draw(renderer, state);
+    flushStats.pixelsRasterized += static_cast<uint32_t>(kWidth) * kHeight;
+  } else {
+    for (uint16_t i = 0; i < flushRectCount; ++i) {
+      const FlushRect &r = flushRects[i];
+      displayList->replay(renderer, r.x, r.y, r.w, r.h);
+      flushStats.pixelsRasterized += static_cast<uint32_t>(r.w) * r.h;
+    }
+  }
+  displayListValid = !displayList->overflowed();
+
+  for (uint16_t i = 0; i < flushRectCount; ++i) {
+    flushStats.pixelsPushed += static_cast<uint32_t>(flushRects[i].w) * flushRects[i].h;
+  }
+  flushStats.rectsPushed += flushRectCount;
+  framePending = flushRectCount > 0;
+}
+#endif
+
+#if FRAME_BAND_ROWS
+// Runs the draw pass once per strip with the renderer clipped to that strip.
+// A strip renders while the previous one streams from the other buffer;
+// strips whose hash did not change since the last frame are not sent.
+// Renders and pushes the bands overlapping rows [top, bottom).
+static void renderBands(int16_t top, int16_t bottom) {
+#if FRAME_INDEXED
+  if (palette.revision() != paletteRevision) {
+    paletteRevision = palette.revision();
+    bandHashValid = false;
+  }
+#endif
+
+  for (int16_t band = 0; band < kBandCount; ++band) {
+    int16_t y = band * kBandRows;
+    int16_t rows = (y + kBandRows <= kHeight) ? kBandRows : (kHeight - y);
+    if (y + rows <= top || y >= bottom) continue;
+    FramePixel *buf = bandBuffers[bandSlot];
+    renderer.setBand(buf, kWidth, kHeight, y, rows, &palette);
+    ui.draw(renderer, state);
+
+    uint32_t start = ESP.getCycleCount();
+    uint32_t hash = hashTile(buf, kWidth, rows);
+    flushStats.checkCycles += ESP.getCycleCount() - start;
+    flushStats.tilesChecked++;
+    if (bandHashValid && hash == bandHash[band]) {
+      flushStats.hashMatches++;
+      continue;
+    }
+    bandHash[band] = hash;
+
+    FlushRect &rect = bandRects[bandSlot];
+    rect.x = 0;
+    rect.y = y;
+    rect.w = kWidth;
+    rect.h = rows;
+    PanelIO::waitFlush();
+#if FRAME_INDEXED
+    PanelIO::beginFlush(&rect, 1, buf, kWidth, palette.table(), y);
+#else
+    PanelIO::beginFlush(&rect, 1, buf, kWidth, y);
+#endif
+    bandSlot ^= 1;
+    flushStats.tilesPushed++;
+    flushStats.rectsPushed++;
+    flushStats.pixelsPushed += static_cast<uint32_t>(kWidth) * rows;
+  }
+  bandHashValid = true;
+}
+#endif
+
+static void reportFlushStats() {
+#if FRAME_STATS
+  uint32_t perTile = flushStats.tilesChecked ? flushStats.checkCycles / flushStats.tilesChecked : 0;
+  Serial.printf("flush: checked %lu dirty %lu rects %lu px %lu (%lu cyc/tile) matches %lu collisions %lu deferred %lu heap %lu\n",
+    static_cast<unsigned long>(flushStats.tilesChecked),
+    static_cast<unsigned long>(flushStats.tilesPushed),
+    static_cast<unsigned long>(flushStats.rectsPushed),
+    static_cast<unsigned long>(flushStats.pixelsPushed),
+    static_cast<unsigned long>(perTile),
+    static_cast<unsigned long>(flushStats.hashMatches),
+    static_cast<unsigned long>(flushStats.collisions),
+    static_cast<unsigned long>(flushStats.framesDeferred),
+    static_cast<unsigned long>(heap_caps_get_free_size(MALLOC_CAP_DMA)));
+#if FRAME_DISPLAY_LIST
+  uint32_t frames = state.fps ? state.fps : 1;
+  Serial.printf("list/frame: recorded %lu changed %lu rasterized %lu px\n",
+    static_cast<unsigned long>(flushStats.commandsRecorded / frames),
+    static_cast<unsigned long>(flushStats.commandsChanged / frames),
+    static_cast<unsigned long>(flushStats.pixelsRasterized / frames));
+#endif
+#if FRAME_IDLE_SKIP
+  uint32_t usPerFrame = flushStats.framesRendered ? flushStats.renderUs / flushStats.framesRendered : 0;
+  Serial.printf("idle: skipped %lu of %lu frames, saved ~%lu us (%lu us/frame)\n",
+    static_cast<unsigned long>(flushStats.framesSkipped),
+    static_cast<unsigned long>(flushStats.framesSkipped + flushStats.framesRendered),
+    static_cast<unsigned long>(flushStats.framesSkipped * usPerFrame),
+    static_cast<unsigned long>(usPerFrame));
+#endif
+  static const char *const kRegionNames[UI_REGION_COUNT] = {"overlay", "content"};
+  static FrameScheduler::Stats reported = {};
+  const FrameScheduler::Stats &regions = scheduler.stats();
+  for (uint8_t r = 0; r < UI_REGION_COUNT; ++r) {
+    uint16_t interval = scheduler.interval(r);
+    Serial.printf("region %s: drawn %lu due %lu target %u Hz\n", kRegionNames[r],
+      static_cast<unsigned long>(regions.drawn[r] - reported.drawn[r]),
+      static_cast<unsigned long>(regions.due[r] - reported.due[r]),
+      interval ? 1000U / interval : 0U);
+  }
+  reported = regions;
+#if FRAME_SCROLL_ACTIVE
+  Serial.printf("scroll: %lu hardware scrolls, offset %d\n", static_cast<unsigned long>(flushStats.scrolls), listScrollOffset);
+#endif
+#if UI_LAYER_CACHE_BYTES
+  const LayerCache::Stats &layers = ui.layerCache().stats();
+  Serial.printf("layers: %u cached, hits %lu misses %lu evictions %lu\n", ui.layerCache().entryCount(),
+    static_cast<unsigned long>(layers.hits),
+    static_cast<unsigned long>(layers.misses),
+    static_cast<unsigned long>(layers.evictions));
+#endif
+#endif
+  flushStats = FlushStats();
+}
+
+#if RENDER_OVERDRAW
+// Writes per pixel of the regions drawn count clears of areas that did not
+// change; writes per pixel covered count only primitives stacking up.
+static void reportOverdraw(ScreenId screen) {
+  const OverdrawTotals &t = overdrawTotals[screen];
+  if (t.frames == 0 || t.writes == 0) return;
+  Serial.printf("overdraw screen %u: %lu frames, %.2f writes/px drawn, %.2f per px covered\n",
+    static_cast<unsigned>(screen), static_cast<unsigned long>(t.frames),
+    static_cast<double>(t.writes) / (t.regionPixels ? t.regionPixels : 1),
+    static_cast<double>(t.writes) / (t.covered ? t.covered : 1));
+  Serial.print("  by primitive:");
+  for (uint8_t k = 0; k < OVERDRAW_KIND_COUNT; ++k) {
+    if (t.kindWrites[k] == 0) continue;
+    Serial.printf(" %s %lu%%", OverdrawMap::kindName(static_cast<OverdrawKind>(k)),
+      static_cast<unsigned long>((static_cast<uint64_t>(t.kindWrites[k]) * 100 + t.writes / 2) / t.writes));
+  }
+  Serial.println("");
+}
+
+static void overdrawBeginFrame() {
+  ScreenId screen = ui.currentScreen();
+  if (screen != overdrawScreen) {
+    reportOverdraw(overdrawScreen);
+    overdrawScreen = screen;
+    overdrawMapped = false;
+  }
+  overdraw.reset();
+}
+
+static void overdrawEndFrame(uint8_t regions, int16_t top, int16_t bottom) {
+  OverdrawTotals &t = overdrawTotals[overdrawScreen];
+  t.frames++;
+  t.writes += overdraw.writes();
+  t.covered += overdraw.covered();
+  t.regionPixels += static_cast<uint32_t>(bottom - top) * kWidth;
+  for (uint8_t k = 0; k < OVERDRAW_KIND_COUNT; ++k) {
+    t.kindWrites[k] += overdraw.writes(static_cast<OverdrawKind>(k));
+  }
+  if (overdrawMapped || regions != UI_REGIONS_ALL) return;
+  Serial.printf("overdraw map screen %u, %dx%d px per char, ' ' 0 '.' 1 ... '@' 9+ writes:\n",
+    static_cast<unsigned>(overdrawScreen), OverdrawMap::kCellW, OverdrawMap::kCellH);
+  overdraw.printHeatmap();
+  overdrawMapped = true;
+  overdrawMaps++;
+}
+#endif
+
+#if SESSION_RECORD
+// ADC noise would log every pass; smaller moves are left out of the session.
+static const int16_t kSessionAdcStep = 24;
+
+// One line per input change: "I <ms> <steer> <throttle> <suspension>
+// <buttons>", buttons being MENU, SET, TRIM+, TRIM-, gyro switch from bit 0.
+static void recordSession(uint32_t nowMs) {
+  static uint8_t lastButtons = 0xFF;
+  static uint16_t lastAdc[3];
+  uint8_t buttons = (state.btnMenu ? 1 : 0) | (state.btnSet ? 2 : 0) | (state.btnTrimPlus ? 4 : 0) |
+                    (state.btnTrimMinus ? 8 : 0) | (digitalRead(PIN_SW_GYRO) == LOW ? 16 : 0);
+  uint16_t adc[3] = {state.rawSteer, state.rawThrottle, state.rawSuspension};
+  bool moved = false;
+  for (uint8_t i = 0; i < 3; ++i) {
+    int16_t delta = static_cast<int16_t>(adc[i] - lastAdc[i]);
+    if (delta >= kSessionAdcStep || delta <= -kSessionAdcStep) moved = true;
+  }
+  if (buttons == lastButtons && !moved) return;
+  lastButtons = buttons;
+  memcpy(lastAdc, adc, sizeof(adc));
+  Serial.printf("I %lu %u %u %u %u\n", static_cast<unsigned long>(nowMs), adc[0], adc[1], adc[2], buttons);
+}
+#endif
+
 static void updateSensors() {
   state.rawSteer = analogRead(PIN_STEERING);
   state.rawThrottle = analogRead(PIN_THROTTLE);
@@ -134,7 +702,55 @@ static void updateTelemetry(uint32_t nowMs) {
   }
 }
 
+#if !FRAME_BAND_ROWS && !FRAME_SINGLE_BUFFER
+// Regions drawn into the front buffer by the last frame; the back buffer
+// still holds their previous contents.
+static uint8_t backStaleRegions = 0;
+#endif
+
+// Draws the given regions and queues their flush. The band and display
+// list modes rebuild whole bands or frames, so they draw every region.
+static void renderRegions(uint8_t regions) {
+  int16_t top, bottom;
+  UiRegionRows(regions, top, bottom);
+#if RENDER_OVERDRAW
+  overdrawBeginFrame();
+#endif
+#if FRAME_BAND_ROWS
+  renderBands(top, bottom);
+#elif FRAME_DISPLAY_LIST
+  renderDisplayList();
+  startPendingFlush();
+#else
+#if FRAME_SCROLL_ACTIVE
+  if (regions & (1U << UI_REGION_CONTENT)) applyHardwareScroll();
+#endif
+#if !FRAME_SINGLE_BUFFER
+  // Regions not drawn this time must match the panel before the diff.
+  uint8_t stale = backStaleRegions & ~regions;
+  if (stale) {
+    int16_t copyTop, copyBottom;
+    UiRegionRows(stale, copyTop, copyBottom);
+    size_t offset = static_cast<size_t>(copyTop) * kWidth;
+    memcpy(backBuffer + offset, frontBuffer + offset, static_cast<size_t>(copyBottom - copyTop) * kWidth * sizeof(FramePixel));
+  }
+  backStaleRegions = regions;
+#endif
+  renderer.setBuffer(backBuffer, kWidth, kHeight, &palette);
+  renderer.beginFrame();
+  ui.draw(renderer, state, regions);
+  flushDirtyTiles(top, bottom);
+  startPendingFlush();
+#endif
+#if RENDER_OVERDRAW
+  overdrawEndFrame(regions, top, bottom);
+#endif
+}
+
 void setup() {
+#if FRAME_MIRROR
+  Serial.setTxBufferSize(FrameMirror::kTxBufferBytes);
+#endif
   Serial.begin(SERIAL_BAUD);
 
   analogReadResolution(12);
@@ -158,9 +774,48 @@ void setup() {
   }
 
   allocateBuffers();
+  if (!planner.begin(kWidth, kHeight, kTileW, kTileH)) {
+    Serial.println("Flush planner tile grid too large");
+    while (true) { delay(100); }
+  }
+#if FRAME_MIRROR
+  if (!mirror.begin(kWidth, kHeight)) {
+    Serial.println("Mirror allocation failed");
+  }
+#endif
+#if FRAME_SCROLL_ACTIVE
+  PanelIO::setScrollArea(kScrollTop, kScrollRows);
+#endif
+#if PERF_BENCH && FRAME_BAND_ROWS
+  // The bench rects span the screen and its reference loops do not clip,
+  // so it gets a full-height scratch frame for as long as it runs.
+  FramePixel *benchFrame = static_cast<FramePixel *>(malloc(static_cast<size_t>(kWidth) * kHeight * sizeof(FramePixel)));
+  if (benchFrame) {
+    PerfBench::run(renderer, benchFrame, kWidth, kHeight, &palette);
+    free(benchFrame);
+  } else {
+    Serial.println("bench skipped: no memory for a full frame");
+  }
+#elif PERF_BENCH
+  PerfBench::run(renderer, backBuffer, kWidth, kHeight, &palette);
+#endif
+#if PERF_BENCH
+  PanelIO::benchRectSetup();
+#endif
+#if RENDER_OVERDRAW
+  // After the benchmarks, so only UI frames are counted.
+  if (overdraw.begin(kWidth, kHeight)) {
+    renderer.setOverdraw(&overdraw);
+  } else {
+    Serial.println("Overdraw map allocation failed");
+  }
+#endif
   renderer.setBuffer(backBuffer, kWidth, kHeight, &palette);
+  if (TEXT_CACHE_BYTES > 0 && textCache.begin(TEXT_CACHE_BYTES)) {
+    renderer.setTextCache(&textCache);
+  }
 
-  lastFrameMs = millis();
+  scheduler.begin(UI_REGION_COUNT, millis());
   lastFpsMs = millis();
   lastSimMs = millis();
   lastDriveMs = millis();
@@ -172,31 +827,53 @@ void loop() {
 
   InputActions actions = input.update();
   updateSensors();
+#if SESSION_RECORD
+  recordSession(nowMs);
+#endif
   updateTelemetry(nowMs);
+  ui.update(state, nowMs);
   ui.handleInput(actions, state);
+  startPendingFlush();
 
-  if (nowMs - lastFrameMs >= 33) {
-    lastFrameMs = nowMs;
-
-    renderer.setBuffer(backBuffer, kWidth, kHeight, &palette);
-    ui.draw(renderer, state);
-    flushDirtyTiles();
-
-    uint16_t *tmp = frontBuffer;
-    frontBuffer = backBuffer;
-    backBuffer = tmp;
-
-    frameCount++;
-    if (nowMs - lastFpsMs >= 1000) {
-      state.fps = frameCount;
-      frameCount = 0;
-      lastFpsMs = nowMs;
+  for (uint8_t r = 0; r < UI_REGION_COUNT; ++r) {
+    scheduler.setInterval(r, ui.regionIntervalMs(r));
+  }
+  uint8_t due = scheduler.due(nowMs);
+  if (!backBufferFree()) {
+    if (due) flushStats.framesDeferred++;
+  } else {
+    uint8_t regions = ui.regionsToDraw(state, palette.revision(), nowMs, due);
+    if (regions) {
+      uint32_t renderStartUs = micros();
+      renderRegions(regions);
+      flushStats.renderUs += micros() - renderStartUs;
+      flushStats.framesRendered++;
+      frameCount++;
+    } else if (due) {
+      flushStats.framesSkipped++;
     }
+    scheduler.advance(due, regions, nowMs);
+  }
+
+  if (nowMs - lastFpsMs >= 1000) {
+    state.fps = frameCount;
+    frameCount = 0;
+    lastFpsMs = nowMs;
+    reportFlushStats();
   }
 
   state.loopTimeUs = micros() - frameStartUs;
   state.memFree = ESP.getFreeHeap();
+  state.textCacheHits = textCache.stats().hits;
+  state.textCacheMisses = textCache.stats().misses;
+  state.textCacheBytes = textCache.bytesUsed();
+  state.textCacheSize = textCache.capacity();
   state.cpuLoad = static_cast<uint8_t>(constrain(state.loopTimeUs / 1000, 0, 100));
 
+#if FRAME_MIRROR
+  // After the loop time is taken: the mirror is a debug aid, not UI work.
+  mirror.service(FRAME_SINGLE_BUFFER ? backBuffer : frontBuffer, FRAME_INDEXED ? palette.table() : nullptr, nowMs);
+#endif
+
   buzzer.update(state);
 }
@@ -0,0 +1,112 @@
+#include "TextCache.h"
+
+#include "Font5x7.h"
+
+namespace {
+// Transposes a character's font columns into one 5-bit mask per row.
+void glyphRows(char c, uint8_t *rows) {
+  if (c < 32 || c > 126) c = '?';
+  uint16_t idx = (c - 32) * 5;
+  memset(rows, 0, 7);
+  for (uint8_t i = 0; i < 5; ++i) {
+    uint8_t line = pgm_read_byte(kFont5x7 + idx + i);
+    for (uint8_t j = 0; j < 7; ++j) {
+      rows[j] |= ((line >> j) & 0x01) << i;
+    }
+  }
+}
+
+// Writes the spans of text to out (if not null) and returns their number.
+uint16_t rasterize(const char *text, uint8_t len, TextSpan *out) {
+  uint16_t count = 0;
+  uint8_t rows[7];
+  for (uint8_t k = 0; k < len; ++k) {
+    glyphRows(text[k], rows);
+    for (uint8_t j = 0; j < 7; ++j) {
+      uint8_t mask = rows[j];
+      uint8_t i = 0;
+      while (mask) {
+        while (!(mask & 0x01)) { mask >>= 1; ++i; }
+        uint8_t start = i;
+        while (mask & 0x01) { mask >>= 1; ++i; }
+        if (out) {
+          out[count].row = j;
+          out[count].x0 = k * 6 + start;
+          out[count].x1 = k * 6 + i;
+        }
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+}  // namespace
+
+bool TextCache::begin(size_t arenaBytes) {
+  if (arenaBytes > 0xFFFF) arenaBytes = 0xFFFF;
+  free(arena);
+  arena = static_cast<uint8_t *>(malloc(arenaBytes));
+  arenaSize = arena ? arenaBytes : 0;
+  used = 0;
+  entryCount = 0;
+  return arena != nullptr;
+}
+
+void TextCache::evict(uint8_t index) {
+  Entry &victim = entries[index];
+  size_t bytes = victim.len + victim.spanCount * sizeof(TextSpan);
+  size_t end = victim.offset + bytes;
+  memmove(arena + victim.offset, arena + end, used - end);
+  used -= bytes;
+  for (uint8_t i = 0; i < entryCount; ++i) {
+    if (entries[i].offset > victim.offset) entries[i].offset -= bytes;
+  }
+  entries[index] = entries[--entryCount];
+  counters.evictions++;
+}
+
+const TextSpan *TextCache::spans(const char *text, uint16_t &count) {
+  if (!arena || !text) return nullptr;
+  uint32_t hash = 0x811C9DC5;
+  size_t len = 0;
+  for (const char *p = text; *p; ++p, ++len) {
+    hash = (hash ^ static_cast<uint8_t>(*p)) * 0x01000193;
+  }
+  if (len == 0 || len > kMaxChars) return nullptr;
+
+  ++useClock;
+  for (uint8_t i = 0; i < entryCount; ++i) {
+    Entry &e = entries[i];
+    if (e.hash == hash && e.len == len && memcmp(arena + e.offset, text, len) == 0) {
+      e.lastUse = useClock;
+      counters.hits++;
+      count = e.spanCount;
+      return reinterpret_cast<const TextSpan *>(arena + e.offset + len);
+    }
+  }
+
+  counters.misses++;
+  uint16_t spanCount = rasterize(text, static_cast<uint8_t>(len), nullptr);
+  size_t need = len + spanCount * sizeof(TextSpan);
+  if (need > arenaSize) return nullptr;
+  while (entryCount > 0 && (entryCount >= kMaxEntries || used + need > arenaSize)) {
+    uint8_t oldest = 0;
+    for (uint8_t i = 1; i < entryCount; ++i) {
+      if (entries[i].lastUse < entries[oldest].lastUse) oldest = i;
+    }
+    evict(oldest);
+  }
+
+  Entry &e = entries[entryCount++];
+  e.hash = hash;
+  e.lastUse = useClock;
+  e.offset = static_cast<uint16_t>(used);
+  e.spanCount = spanCount;
+  e.len = static_cast<uint8_t>(len);
+  memcpy(arena + used, text, len);
+  TextSpan *out = reinterpret_cast<TextSpan *>(arena + used + len);
+  rasterize(text, static_cast<uint8_t>(len), out);
+  used += need;
+  count = spanCount;
+  return out;
+}
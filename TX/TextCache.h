@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Arduino.h>
+
+// One horizontal run of lit font pixels: glyph row 0-6 and columns
+// [x0, x1) in unscaled text pixels, six per character cell.
+struct TextSpan {
+  uint8_t row;
+  uint8_t x0;
+  uint8_t x1;
+};
+
+// LRU cache of rasterized strings. A string is stored once as its span
+// list; scale and color are applied when the spans are filled, so one
+// entry serves every size and color the label is drawn in. Text and
+// spans share one arena that is compacted when an entry is evicted.
+class TextCache {
+public:
+  static const uint8_t kMaxEntries = 48;
+  static const uint8_t kMaxChars = 42;
+
+  struct Stats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+  };
+
+  TextCache() = default;
+  ~TextCache() { free(arena); }
+  TextCache(const TextCache &) = delete;
+  TextCache &operator=(const TextCache &) = delete;
+
+  bool begin(size_t arenaBytes);
+
+  // Returns the spans for text, rasterizing it on a miss. The pointer is
+  // valid until the next call. Returns nullptr for strings the cache
+  // cannot hold; the caller draws those glyph by glyph.
+  const TextSpan *spans(const char *text, uint16_t &count);
+
+  const Stats &stats() const { return counters; }
+  size_t bytesUsed() const { return used + entryCount * sizeof(Entry); }
+  size_t capacity() const { return arenaSize; }
+
+private:
+  struct Entry {
+    uint32_t hash;
+    uint32_t lastUse;
+    uint16_t offset;
+    uint16_t spanCount;
+    uint8_t len;
+  };
+
+  void evict(uint8_t index);
+
+  Entry entries[kMaxEntries];
+  uint8_t entryCount = 0;
+  uint8_t *arena = nullptr;
+  size_t arenaSize = 0;
+  size_t used = 0;
+  uint32_t useClock = 0;
+  Stats counters;
+};
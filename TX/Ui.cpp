@@ -28,6 +28,7 @@
 #include "ScreenWireless.h"
 #include "UiDraw.h"
 #include "UiLayout.h"
+#include "UiMenu.h"
 
 namespace {
 static const ScreenId kScreenOrder[] = {
@@ -56,13 +57,39 @@ static const ScreenId kScreenOrder[] = {
   SCREEN_SAFE_SHUTDOWN
 };
 
-int clampInt(int value, int minVal, int maxVal) {
-  if (value < minVal) return minVal;
-  if (value > maxVal) return maxVal;
-  return value;
-}
+// Indexed by ScreenId; the boot splash is drawn outside the table.
+constexpr const UiScreenDesc *kScreens[] = {
+  nullptr,
+  &ScreenDashboard_Desc,
+  &ScreenTelemetry_Desc,
+  &ScreenAccessoryControl_Desc,
+  &ScreenAccessoryMapping_Desc,
+  &ScreenGyro_Desc,
+  &ScreenSteering_Desc,
+  &ScreenThrottle_Desc,
+  &ScreenSuspension_Desc,
+  &ScreenInputMonitor_Desc,
+  &ScreenTrim_Desc,
+  &ScreenProfileSelect_Desc,
+  &ScreenProfileEdit_Desc,
+  &ScreenBattery_Desc,
+  &ScreenFailsafe_Desc,
+  &ScreenAlerts_Desc,
+  &ScreenSystem_Desc,
+  &ScreenPerformance_Desc,
+  &ScreenLogging_Desc,
+  &ScreenCalibration_Desc,
+  &ScreenWireless_Desc,
+  &ScreenDiagnostics_Desc,
+  &ScreenDeveloper_Desc,
+  &ScreenSafeShutdown_Desc
+};
+static_assert(sizeof(kScreens) / sizeof(kScreens[0]) == SCREEN_COUNT, "kScreens must cover every ScreenId");
 
-float clampFloat(float value, float minVal, float maxVal) {
+// State read by the status bar and temperature strip on every screen.
+static const uint16_t kOverlayDeps = UI_DEP_LINK | UI_DEP_GYRO | UI_DEP_POWER | UI_DEP_TEMPS;
+
+int clampInt(int value, int minVal, int maxVal) {
   if (value < minVal) return minVal;
   if (value > maxVal) return maxVal;
   return value;
@@ -72,10 +99,18 @@ float clampFloat(float value, float minVal, float maxVal) {
 void UiManager::begin() {
   ctx.current = SCREEN_BOOT;
   ctx.bootStartMs = millis();
+  layers.begin(UI_LAYER_CACHE_BYTES, UiLayout::ScreenW, UiLayout::ContentH);
+}
+
+void UiManager::update(const UiState &state, uint32_t nowMs) {
+  ScreenTelemetry_Sample(state, nowMs);
 }
 
 void UiManager::handleInput(const InputActions &actions, UiState &state) {
   if (ctx.current == SCREEN_BOOT) {
+    if (millis() - ctx.bootStartMs > 350) {
+      ctx.current = SCREEN_DASHBOARD;
+    }
     return;
   }
 
@@ -109,78 +144,13 @@ void UiManager::handleInput(const InputActions &actions, UiState &state) {
     return;
   }
 
-  switch (ctx.current) {
-    case SCREEN_ACCESSORY_CTRL:
-      handleListInput(ctx.current, 5, actions, state, true);
-      break;
-    case SCREEN_TELEMETRY:
-      handleListInput(ctx.current, 7, actions, state, false);
-      break;
-    case SCREEN_ACCESSORY_MAP:
-      handleListInput(ctx.current, 5, actions, state, false);
-      break;
-    case SCREEN_GYRO:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_STEERING:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_THROTTLE:
-      handleListInput(ctx.current, 5, actions, state, false);
-      break;
-    case SCREEN_SUSPENSION:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_INPUT_MON:
-      handleListInput(ctx.current, 6, actions, state, false);
-      break;
-    case SCREEN_TRIM:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_PROFILE_SELECT:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_PROFILE_EDIT:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_BATTERY:
-      handleListInput(ctx.current, 3, actions, state, false);
-      break;
-    case SCREEN_FAILSAFE:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_ALERTS:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_SYSTEM:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_PERF:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_LOGGING:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_CALIBRATION:
-      ScreenCalibration_HandleInput(actions, state, ctx);
-      break;
-    case SCREEN_WIRELESS:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    case SCREEN_DIAGNOSTICS:
-      handleListInput(ctx.current, 3, actions, state, false);
-      break;
-    case SCREEN_DEVELOPER:
-      handleListInput(ctx.current, 3, actions, state, false);
-      break;
-    case SCREEN_SAFE_SHUTDOWN:
-      handleListInput(ctx.current, 4, actions, state, false);
-      break;
-    default:
-      if (actions.setShort) {
-        ctx.editMode[ctx.current] = !ctx.editMode[ctx.current];
-      }
-      break;
+  const UiScreenDesc &screen = *kScreens[ctx.current];
+  if (screen.input) {
+    screen.input(actions, state, ctx);
+  } else if (screen.itemCount > 0) {
+    handleListInput(ctx.current, screen, actions, state);
+  } else if (actions.setShort) {
+    ctx.editMode[ctx.current] = !ctx.editMode[ctx.current];
   }
 }
 
@@ -229,25 +199,23 @@ void UiManager::handleContext(const InputActions &actions, UiState &state) {
   }
 }
 
-void UiManager::handleListInput(ScreenId id, int itemCount, const InputActions &actions, UiState &state, bool directAdjust) {
+void UiManager::handleListInput(ScreenId id, const UiScreenDesc &screen, const InputActions &actions,
+                                UiState &state) {
+  int itemCount = screen.itemCount;
+  const UiItem &item = screen.items[ctx.focus[id]];
   if (actions.setShort) {
-    if (id == SCREEN_TRIM && ctx.focus[id] == 2) {
-      state.steerTrim = 0;
-      state.throttleTrim = 0;
-    } else if (id == SCREEN_PROFILE_SELECT) {
-      state.activeProfile = ctx.focus[id];
-    } else if (id == SCREEN_SAFE_SHUTDOWN) {
-      // Placeholder for safe actions.
-    } else if (directAdjust) {
+    if (item.action) {
+      item.action(state, ctx, ctx.focus[id]);
+    } else if (screen.directAdjust) {
       ctx.confirmUntilMs = millis() + 400;
-    } else if (!directAdjust) {
+    } else {
       ctx.editMode[id] = !ctx.editMode[id];
     }
   }
 
   if (actions.trimDelta != 0) {
-    if (directAdjust || ctx.editMode[id]) {
-      adjustValue(id, ctx.focus[id], actions.trimDelta, state);
+    if (screen.directAdjust || ctx.editMode[id]) {
+      UiMenuAdjust(item, actions.trimDelta, state);
     } else {
       int next = static_cast<int>(ctx.focus[id]) + actions.trimDelta;
       ctx.focus[id] = static_cast<uint8_t>(clampInt(next, 0, itemCount - 1));
@@ -270,232 +238,156 @@ void UiManager::adjustScroll(ScreenId id, int itemCount, int visibleCount) {
   } else if (focus >= scroll + visibleCount) {
     scroll = focus - visibleCount + 1;
   }
+  if (scroll != ctx.scroll[id]) {
+    if (pendingScrollScreen != id) pendingScrollRows = 0;
+    pendingScrollRows += (scroll - ctx.scroll[id]) * UiLayout::ItemH;
+    pendingScrollScreen = id;
+  }
   ctx.scroll[id] = scroll;
 }
 
-void UiManager::adjustValue(ScreenId id, int index, int delta, UiState &state) {
-  switch (id) {
-    case SCREEN_ACCESSORY_CTRL:
-      if (index == 0) {
-        state.headlights = static_cast<AccessoryTriState>((state.headlights + 3 + delta) % 3);
-      } else if (index == 1) {
-        state.taillights = static_cast<AccessoryOnOff>((state.taillights + 2 + delta) % 2);
-      } else if (index == 2) {
-        state.turnSignals = static_cast<TurnSignalState>((state.turnSignals + 4 + delta) % 4);
-      } else if (index == 3) {
-        state.brakeLights = static_cast<BrakeState>((state.brakeLights + 2 + delta) % 2);
-      } else if (index == 4) {
-        state.auxOutput = static_cast<uint8_t>((state.auxOutput + 4 + delta) % 4);
-      }
-      break;
-    case SCREEN_ACCESSORY_MAP:
-      if (index < 5) {
-        state.accessoryMap[index] = static_cast<uint8_t>((state.accessoryMap[index] + 6 + delta) % 6);
-      }
-      break;
-    case SCREEN_GYRO:
-      if (index == 0) {
-        state.gyroOverride = !state.gyroOverride;
-      } else if (index == 1) {
-        state.gyroGain = static_cast<uint8_t>(clampInt(state.gyroGain + delta * 2, 0, 100));
-      } else if (index == 2) {
-        state.gyroMode = static_cast<GyroMode>((state.gyroMode + 2 + delta) % 2);
-      } else if (index == 3) {
-        state.gyroResponse = static_cast<uint8_t>(clampInt(state.gyroResponse + delta * 2, 0, 100));
-      }
-      break;
-    case SCREEN_STEERING:
-      if (index == 0) {
-        state.steerDeadzone = static_cast<uint8_t>(clampInt(state.steerDeadzone + delta, 0, 20));
-      } else if (index == 1) {
-        state.steerCenter = static_cast<int8_t>(clampInt(state.steerCenter + delta, -20, 20));
-      } else if (index == 2) {
-        state.steerExpo = static_cast<uint8_t>(clampInt(state.steerExpo + delta, 0, 50));
-      } else if (index == 3) {
-        state.steerEndpoint = static_cast<uint8_t>(clampInt(state.steerEndpoint + delta, 80, 120));
-      }
-      break;
-    case SCREEN_THROTTLE:
-      if (index == 0) {
-        state.throttleDeadzone = static_cast<uint8_t>(clampInt(state.throttleDeadzone + delta, 0, 20));
-      } else if (index == 1) {
-        state.throttleCenter = static_cast<int8_t>(clampInt(state.throttleCenter + delta, -20, 20));
-      } else if (index == 2) {
-        state.throttleCurve = static_cast<uint8_t>(clampInt(state.throttleCurve + delta, 0, 50));
-      } else if (index == 3) {
-        state.brakeStrength = static_cast<uint8_t>(clampInt(state.brakeStrength + delta * 2, 0, 100));
-      } else if (index == 4) {
-        state.reverseLogic = !state.reverseLogic;
-      }
-      break;
-    case SCREEN_SUSPENSION:
-      if (index == 0) {
-        state.suspensionMode = static_cast<SuspensionMode>((state.suspensionMode + 2 + delta) % 2);
-      } else if (index == 1) {
-        state.suspensionPotMap = static_cast<uint8_t>(clampInt(state.suspensionPotMap + delta * 2, 0, 100));
-      } else if (index == 2) {
-        state.suspensionSpeedLogic = static_cast<uint8_t>(clampInt(state.suspensionSpeedLogic + delta * 2, 0, 100));
-      } else if (index == 3) {
-        state.suspensionPreset = static_cast<SuspensionPreset>((state.suspensionPreset + 3 + delta) % 3);
-      }
-      break;
-    case SCREEN_TRIM:
-      if (index == 0) {
-        state.steerTrim = static_cast<int16_t>(clampInt(state.steerTrim + delta, -20, 20));
-      } else if (index == 1) {
-        state.throttleTrim = static_cast<int16_t>(clampInt(state.throttleTrim + delta, -20, 20));
-      } else if (index == 3) {
-        state.trimPerProfile = !state.trimPerProfile;
-      }
-      break;
-    case SCREEN_BATTERY:
-      if (index == 0) {
-        state.txVoltageWarn = clampFloat(state.txVoltageWarn + (delta * 0.1f), 6.0f, 8.4f);
-      } else if (index == 1) {
-        state.rxVoltageWarn = clampFloat(state.rxVoltageWarn + (delta * 0.1f), 5.8f, 7.6f);
-      } else if (index == 2) {
-        state.voltageSagDetect = !state.voltageSagDetect;
-      }
-      break;
-    case SCREEN_FAILSAFE:
-      if (index == 0) {
-        state.failsafeMode = static_cast<FailsafeMode>((state.failsafeMode + 3 + delta) % 3);
-      } else if (index == 1) {
-        state.throttleCut = !state.throttleCut;
-      } else if (index == 2) {
-        state.steeringCenter = !state.steeringCenter;
-      } else if (index == 3) {
-        state.alertSignal = !state.alertSignal;
-      }
-      break;
-    case SCREEN_ALERTS:
-      if (index == 0) {
-        state.alertTemp = !state.alertTemp;
-      } else if (index == 1) {
-        state.alertVoltage = !state.alertVoltage;
-      } else if (index == 2) {
-        state.buzzerVolume = static_cast<uint8_t>(clampInt(state.buzzerVolume + delta * 5, 0, 100));
-      } else if (index == 3) {
-        state.buzzerMute = !state.buzzerMute;
-      }
-      break;
-    case SCREEN_SYSTEM:
-      if (index == 0) {
-        state.displayBrightness = static_cast<uint8_t>(clampInt(state.displayBrightness + delta * 5, 10, 100));
-      } else if (index == 1) {
-        state.sleepTimeoutSec = static_cast<uint16_t>(clampInt(state.sleepTimeoutSec + delta * 30, 60, 900));
-      } else if (index == 2) {
-        state.ledMode = static_cast<LedMode>((state.ledMode + 3 + delta) % 3);
-      } else if (index == 3) {
-        state.bootMode = static_cast<BootMode>((state.bootMode + 2 + delta) % 2);
-      }
-      break;
-    case SCREEN_DEVELOPER:
-      if (index == 0) {
-        state.expertMode = !state.expertMode;
-      } else if (index == 1) {
-        state.experimental = !state.experimental;
-      } else if (index == 2) {
-        state.perfOverride = static_cast<uint8_t>(clampInt(state.perfOverride + delta, 0, 3));
-      }
-      break;
-    case SCREEN_WIRELESS:
-      if (index == 3) {
-        state.reconnectEnabled = !state.reconnectEnabled;
+int16_t UiManager::takeScrollRows() {
+  int16_t rows = (pendingScrollScreen == ctx.current) ? pendingScrollRows : 0;
+  pendingScrollRows = 0;
+  return rows;
+}
+
+uint8_t UiManager::regionsToDraw(const UiState &state, uint16_t paletteRevision, uint32_t nowMs, uint8_t due) {
+  uint8_t id = ctx.current;
+  ViewKey view = {};
+  view.screen = ctx.current;
+  view.focus = ctx.focus[id];
+  view.scroll = ctx.scroll[id];
+  view.editing = ctx.editMode[id];
+  view.contextActive = ctx.contextActive;
+  view.contextIndex = ctx.contextIndex;
+  view.confirming = ctx.confirmUntilMs > nowMs;
+  view.paletteRevision = paletteRevision;
+
+  uint8_t regions = 0;
+  if (!drawnValid || view.screen != drawnView.screen || view.paletteRevision != drawnView.paletteRevision) {
+    regions = UI_REGIONS_ALL;
+  } else if (view.focus != drawnView.focus || view.scroll != drawnView.scroll ||
+             view.editing != drawnView.editing || view.contextActive != drawnView.contextActive ||
+             view.contextIndex != drawnView.contextIndex || view.confirming != drawnView.confirming) {
+    regions = 1U << UI_REGION_CONTENT;
+  }
+  drawnView = view;
+  drawnValid = true;
+
+#if FRAME_IDLE_SKIP
+  if (due & ~regions) {
+    tracker.update(state);
+    uint16_t deps[UI_REGION_COUNT] = {kOverlayDeps, 0};
+    bool live[UI_REGION_COUNT] = {false, false};
+    if (id != SCREEN_BOOT) {
+      deps[UI_REGION_CONTENT] = kScreens[id]->deps;
+      live[UI_REGION_CONTENT] = kScreens[id]->live && kScreens[id]->live(ctx);
+    }
+    for (uint8_t r = 0; r < UI_REGION_COUNT; ++r) {
+      uint8_t bit = 1U << r;
+      if (!(due & bit) || (regions & bit)) continue;
+      bool redraw = live[r] || nowMs - drawnMs[r] >= FRAME_IDLE_REFRESH_MS;
+      for (uint8_t i = 0; i < UiStateTracker::kGroups && !redraw; ++i) {
+        if ((deps[r] & (1U << i)) && tracker.version(i) != drawnVersions[r][i]) redraw = true;
       }
-      break;
-    default:
-      break;
+      if (redraw) regions |= bit;
+    }
+  }
+#else
+  (void)state;
+  regions |= due;
+#endif
+  // The boot splash covers both regions.
+  if (regions && id == SCREEN_BOOT) regions = UI_REGIONS_ALL;
+
+  for (uint8_t r = 0; r < UI_REGION_COUNT; ++r) {
+    if (!(regions & (1U << r))) continue;
+    for (uint8_t i = 0; i < UiStateTracker::kGroups; ++i) {
+      drawnVersions[r][i] = tracker.version(i);
+    }
+    drawnMs[r] = nowMs;
   }
+  return regions;
 }
 
-void UiManager::draw(Renderer &renderer, UiState &state) {
+uint16_t UiManager::regionIntervalMs(uint8_t region) const {
+  if (region == UI_REGION_CONTENT && ctx.current != SCREEN_BOOT) {
+    const UiScreenDesc &screen = *kScreens[ctx.current];
+    return (screen.live && screen.live(ctx)) ? static_cast<uint16_t>(UI_REFRESH_60HZ) : screen.refreshMs;
+  }
+  return FRAME_OVERLAY_MS;
+}
+
+void UiRegionRows(uint8_t regions, int16_t &top, int16_t &bottom) {
+  top = (regions & (1U << UI_REGION_OVERLAY)) ? 0 : UiLayout::ContentY;
+  bottom = (regions & (1U << UI_REGION_CONTENT)) ? UiLayout::ScreenH : UiLayout::ContentY;
+}
+
+void UiManager::draw(Renderer &renderer, UiState &state, uint8_t regions) {
   if (ctx.current == SCREEN_BOOT) {
     ScreenBoot_Draw(renderer);
-    if (millis() - ctx.bootStartMs > 350) {
-      ctx.current = SCREEN_DASHBOARD;
-    }
     return;
   }
 
+  bool partial = regions != UI_REGIONS_ALL;
+  if (partial) {
+    int16_t top, bottom;
+    UiRegionRows(regions, top, bottom);
+    renderer.setClip(0, top, UiLayout::ScreenW, bottom - top);
+  }
   renderer.clear(BG_PRIMARY);
-  UiDrawOverlay(renderer, state);
-
-  switch (ctx.current) {
-    case SCREEN_DASHBOARD:
-      ScreenDashboard_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_TELEMETRY:
-      ScreenTelemetry_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_ACCESSORY_CTRL:
-      ScreenAccessoryControl_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_ACCESSORY_MAP:
-      ScreenAccessoryMapping_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_GYRO:
-      ScreenGyro_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_STEERING:
-      ScreenSteering_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_THROTTLE:
-      ScreenThrottle_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_SUSPENSION:
-      ScreenSuspension_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_INPUT_MON:
-      ScreenInputMonitor_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_TRIM:
-      ScreenTrim_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_PROFILE_SELECT:
-      ScreenProfileSelect_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_PROFILE_EDIT:
-      ScreenProfileEdit_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_BATTERY:
-      ScreenBattery_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_FAILSAFE:
-      ScreenFailsafe_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_ALERTS:
-      ScreenAlerts_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_SYSTEM:
-      ScreenSystem_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_PERF:
-      ScreenPerformance_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_LOGGING:
-      ScreenLogging_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_CALIBRATION:
-      ScreenCalibration_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_WIRELESS:
-      ScreenWireless_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_DIAGNOSTICS:
-      ScreenDiagnostics_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_DEVELOPER:
-      ScreenDeveloper_Draw(renderer, state, ctx);
-      break;
-    case SCREEN_SAFE_SHUTDOWN:
-      ScreenSafeShutdown_Draw(renderer, state, ctx);
-      break;
-    default:
-      break;
+  if (regions & (1U << UI_REGION_OVERLAY)) {
+    UiDrawOverlay(renderer, state);
   }
 
-  if (ctx.contextActive) {
-    UiDrawContextMenu(renderer, ctx);
+  if (regions & (1U << UI_REGION_CONTENT)) {
+    if (drawStaticLayer(renderer, state)) {
+      UiDrawSetPass(UI_PASS_DYNAMIC);
+      drawScreen(renderer, state);
+      UiDrawSetPass(UI_PASS_ALL);
+    } else {
+      drawScreen(renderer, state);
+    }
+
+    if (ctx.contextActive) {
+      UiDrawContextMenu(renderer, ctx);
+    }
   }
+  if (partial) renderer.resetClip();
+}
+
+// Copies the current screen's static layer into the frame, rendering it
+// into the cache first on a miss. Returns false when the screen has to be
+// drawn in full instead.
+bool UiManager::drawStaticLayer(Renderer &renderer, const UiState &state) {
+  if (!kScreens[ctx.current]->staticLayer || renderer.recording()) return false;
+  const Palette *palette = renderer.activePalette();
+  if (!palette) return false;
+  if (palette->revision() != layerPaletteRevision) {
+    layerPaletteRevision = palette->revision();
+    layers.invalidate();
+  }
+
+  uint8_t id = ctx.current;
+  uint32_t key = (static_cast<uint32_t>(id) << 24) | (static_cast<uint32_t>(ctx.focus[id]) << 16) |
+                 (static_cast<uint32_t>(ctx.scroll[id]) << 8) | (ctx.editMode[id] ? 1 : 0);
+  bool fresh = false;
+  FramePixel *pixels = layers.acquire(key, fresh);
+  if (!pixels) return false;
+
+  if (fresh) {
+    layerRenderer.setBand(pixels, UiLayout::ScreenW, UiLayout::ScreenH, UiLayout::ContentY, UiLayout::ContentH,
+                          palette);
+    layerRenderer.clear(BG_PRIMARY);
+    UiDrawSetPass(UI_PASS_STATIC);
+    drawScreen(layerRenderer, state);
+    UiDrawSetPass(UI_PASS_ALL);
+  }
+  renderer.blit(pixels, 0, UiLayout::ContentY, UiLayout::ScreenW, UiLayout::ContentH);
+  return true;
+}
+
+void UiManager::drawScreen(Renderer &renderer, const UiState &state) {
+  UiMenuDraw(renderer, ctx.current, *kScreens[ctx.current], state, ctx);
 }
@@ -2,9 +2,14 @@
 
 #include <Arduino.h>
 
+#include "HardwareConfig.h"
 #include "InputManager.h"
+#include "LayerCache.h"
 #include "Renderer.h"
 #include "UiState.h"
+#include "UiTracker.h"
+
+struct UiScreenDesc;
 
 enum ScreenId : uint8_t {
   SCREEN_BOOT = 0,
@@ -34,6 +39,18 @@ enum ScreenId : uint8_t {
   SCREEN_COUNT
 };
 
+// Screen areas refreshed on their own deadlines: the status bar plus
+// temperature strip, and everything below them.
+enum UiRegion : uint8_t {
+  UI_REGION_OVERLAY,
+  UI_REGION_CONTENT,
+  UI_REGION_COUNT
+};
+static const uint8_t UI_REGIONS_ALL = (1U << UI_REGION_COUNT) - 1;
+
+// Screen rows [top, bottom) covered by a mask of regions.
+void UiRegionRows(uint8_t regions, int16_t &top, int16_t &bottom);
+
 struct UiContext {
   ScreenId current = SCREEN_BOOT;
   uint8_t focus[SCREEN_COUNT] = {0};
@@ -49,17 +66,57 @@ class UiManager {
 public:
   void begin();
   void handleInput(const InputActions &actions, UiState &state);
-  void draw(Renderer &renderer, UiState &state);
+  // Advances history screens keep between frames, such as telemetry
+  // traces. Runs every loop pass whether or not anything is drawn.
+  void update(const UiState &state, uint32_t nowMs);
+  // Draws the given regions; the rest of the buffer is left untouched.
+  void draw(Renderer &renderer, UiState &state, uint8_t regions = UI_REGIONS_ALL);
   ScreenId currentScreen() const { return ctx.current; }
+  const LayerCache &layerCache() const { return layers; }
+  // Regions that have to be drawn now. Navigation redraws the content at
+  // once (and a new screen or palette everything); a region in due is
+  // drawn when state it reads changed since it was last drawn, its idle
+  // refresh interval ran out, or the screen says its view is live.
+  // Returned regions count as drawn.
+  uint8_t regionsToDraw(const UiState &state, uint16_t paletteRevision, uint32_t nowMs, uint8_t due);
+  // Refresh interval the current screen wants for a region.
+  uint16_t regionIntervalMs(uint8_t region) const;
+  // Pixel rows the current list moved up since the last call (negative:
+  // down), for hardware scrolling. Moves on other screens are dropped.
+  int16_t takeScrollRows();
 
 private:
+  // Everything outside UiState that changes what the current screen shows.
+  struct ViewKey {
+    ScreenId screen;
+    uint8_t focus;
+    uint8_t scroll;
+    bool editing;
+    bool contextActive;
+    uint8_t contextIndex;
+    bool confirming;
+    uint16_t paletteRevision;
+  };
+
   UiContext ctx;
+  LayerCache layers;
+  Renderer layerRenderer;
+  uint16_t layerPaletteRevision = 0;
+  UiStateTracker tracker;
+  uint16_t drawnVersions[UI_REGION_COUNT][UiStateTracker::kGroups] = {{0}};
+  uint32_t drawnMs[UI_REGION_COUNT] = {0};
+  ViewKey drawnView = {};
+  bool drawnValid = false;
+  int16_t pendingScrollRows = 0;
+  ScreenId pendingScrollScreen = SCREEN_BOOT;
+
+  void drawScreen(Renderer &renderer, const UiState &state);
+  bool drawStaticLayer(Renderer &renderer, const UiState &state);
 
   void gotoHome();
   void gotoNextScreen();
   void goBack();
   void handleContext(const InputActions &actions, UiState &state);
-  void handleListInput(ScreenId id, int itemCount, const InputActions &actions, UiState &state, bool directAdjust);
+  void handleListInput(ScreenId id, const UiScreenDesc &screen, const InputActions &actions, UiState &state);
   void adjustScroll(ScreenId id, int itemCount, int visibleCount);
-  void adjustValue(ScreenId id, int index, int delta, UiState &state);
 };
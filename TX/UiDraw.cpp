@@ -1,5 +1,6 @@
 #include "UiDraw.h"
 
+#include "UiFormat.h"
 #include "UiLayout.h"
 
 namespace {
@@ -11,8 +12,22 @@ ColorToken tempColor(float temp) {
 
 static const char *kContextItems[] = {"ADVANCED", "RESET", "CLOSE"};
 static const uint8_t kContextCount = 3;
+
+UiDrawPass currentPass = UI_PASS_ALL;
 }  // namespace
 
+void UiDrawSetPass(UiDrawPass pass) {
+  currentPass = pass;
+}
+
+bool UiDrawStatic() {
+  return currentPass != UI_PASS_DYNAMIC;
+}
+
+bool UiDrawDynamic() {
+  return currentPass != UI_PASS_STATIC;
+}
+
 void UiDrawOverlay(Renderer &renderer, const UiState &state) {
   UiDrawStatusBar(renderer, state);
   UiDrawTempStrip(renderer, state);
@@ -28,13 +43,12 @@ void UiDrawStatusBar(Renderer &renderer, const UiState &state) {
   renderer.drawText(28, 3, "GY", 1, TEXT_PRIMARY);
   renderer.fillRect(42, 4, 6, 6, state.gyroOn ? STATE_OK : STATE_WARN);
 
-  char buf[8];
+  static UiFormat::Field rxField;
+  static UiFormat::Field txField;
   if (state.rxVoltageAvailable) {
-    snprintf(buf, sizeof(buf), "R%.1f", state.rxVoltage);
-    renderer.drawTextRight(90, 3, buf, 1, TEXT_PRIMARY);
+    renderer.drawTextRight(90, 3, rxField.fixed(state.rxVoltage, 1, "R"), 1, TEXT_PRIMARY);
   }
-  snprintf(buf, sizeof(buf), "T%.1f", state.txVoltage);
-  renderer.drawTextRight(126, 3, buf, 1, TEXT_PRIMARY);
+  renderer.drawTextRight(126, 3, txField.fixed(state.txVoltage, 1, "T"), 1, TEXT_PRIMARY);
 }
 
 void UiDrawTempStrip(Renderer &renderer, const UiState &state) {
@@ -45,36 +59,39 @@ void UiDrawTempStrip(Renderer &renderer, const UiState &state) {
   renderer.fillRect(segW, y, segW, UiLayout::TempH, tempColor(state.tempEsc));
   renderer.fillRect(segW * 2, y, UiLayout::ScreenW - (segW * 2), UiLayout::TempH, tempColor(state.tempBoard));
 
-  char buf[8];
-  snprintf(buf, sizeof(buf), "M%d", static_cast<int>(state.tempMotor));
-  renderer.drawText(2, y + 2, buf, 1, TEXT_INVERT);
-  snprintf(buf, sizeof(buf), "E%d", static_cast<int>(state.tempEsc));
-  renderer.drawText(segW + 2, y + 2, buf, 1, TEXT_INVERT);
-  snprintf(buf, sizeof(buf), "B%d", static_cast<int>(state.tempBoard));
-  renderer.drawText(segW * 2 + 2, y + 2, buf, 1, TEXT_INVERT);
+  static UiFormat::Field motorField;
+  static UiFormat::Field escField;
+  static UiFormat::Field boardField;
+  renderer.drawText(2, y + 2, motorField.integer(static_cast<int>(state.tempMotor), "M"), 1, TEXT_INVERT);
+  renderer.drawText(segW + 2, y + 2, escField.integer(static_cast<int>(state.tempEsc), "E"), 1, TEXT_INVERT);
+  renderer.drawText(segW * 2 + 2, y + 2, boardField.integer(static_cast<int>(state.tempBoard), "B"), 1, TEXT_INVERT);
 }
 
 void UiDrawListHeader(Renderer &renderer, const char *title) {
+  if (!UiDrawStatic()) return;
   renderer.fillRect(0, UiLayout::ContentY, UiLayout::ScreenW, UiLayout::HeaderH, BG_PANEL_ALT);
   renderer.drawText(6, UiLayout::ContentY + 3, title, 1, TEXT_PRIMARY);
   renderer.drawHLine(0, UiLayout::ContentY + UiLayout::HeaderH - 1, UiLayout::ScreenW, ACCENT_CYAN);
 }
 
-void UiDrawListRow(Renderer &renderer, int row, const char *label, const char *value, bool focused, bool editing) {
+void UiDrawListRow(Renderer &renderer, int row, int index, const char *label, const char *value, bool focused, bool editing) {
   int16_t y = UiLayout::ListY + (row * UiLayout::ItemH);
-  ColorToken bg = (row % 2 == 0) ? BG_PANEL : BG_PANEL_ALT;
-  if (focused) {
-    bg = FOCUS_BG;
-  }
-  renderer.fillRect(0, y, UiLayout::ScreenW, UiLayout::ItemH, bg);
-  ColorToken border = focused ? (editing ? ACCENT_AMBER : FOCUS_BORDER) : GRID_LINE;
-  renderer.drawRect(0, y, UiLayout::ScreenW, UiLayout::ItemH, border);
-  if (focused) {
-    renderer.fillRect(0, y, 3, UiLayout::ItemH, border);
-  }
   int16_t textY = y + (UiLayout::ItemH - renderer.textHeight(1)) / 2;
-  renderer.drawText(6, textY, label, 1, focused ? TEXT_INVERT : TEXT_PRIMARY);
-  if (value) {
+  if (UiDrawStatic()) {
+    // Stripes follow the item, so scrolled rows keep their pixels.
+    ColorToken bg = (index % 2 == 0) ? BG_PANEL : BG_PANEL_ALT;
+    if (focused) {
+      bg = FOCUS_BG;
+    }
+    renderer.fillRect(0, y, UiLayout::ScreenW, UiLayout::ItemH, bg);
+    ColorToken border = focused ? (editing ? ACCENT_AMBER : FOCUS_BORDER) : GRID_LINE;
+    renderer.drawRect(0, y, UiLayout::ScreenW, UiLayout::ItemH, border);
+    if (focused) {
+      renderer.fillRect(0, y, 3, UiLayout::ItemH, border);
+    }
+    renderer.drawText(6, textY, label, 1, focused ? TEXT_INVERT : TEXT_PRIMARY);
+  }
+  if (value && UiDrawDynamic()) {
     renderer.drawTextRight(124, textY, value, 1, focused ? TEXT_INVERT : TEXT_MUTED);
   }
 }
@@ -84,7 +101,8 @@ void UiDrawContextMenu(Renderer &renderer, const UiContext &ctx) {
   int16_t h = (kContextCount * 16) + 8;
   int16_t x = (UiLayout::ScreenW - w) / 2;
   int16_t y = UiLayout::ContentY + 10;
-  renderer.fillRect(x, y, w, h, BG_PANEL);
+  // The screen stays visible, dimmed, behind the menu.
+  renderer.blendRect(x, y, w, h, BG_PANEL, BLEND_75);
   renderer.drawRect(x, y, w, h, ACCENT_CYAN);
 
   for (uint8_t i = 0; i < kContextCount; ++i) {
@@ -5,9 +5,22 @@
 #include "UiLayout.h"
 #include "UiState.h"
 
+// Screens with a cached static layer are drawn in two passes: the static
+// pass renders what only depends on focus/scroll/edit state into the
+// cache, the dynamic pass draws values on top of the copied layer.
+enum UiDrawPass : uint8_t {
+  UI_PASS_ALL,
+  UI_PASS_STATIC,
+  UI_PASS_DYNAMIC
+};
+
+void UiDrawSetPass(UiDrawPass pass);
+bool UiDrawStatic();
+bool UiDrawDynamic();
+
 void UiDrawOverlay(Renderer &renderer, const UiState &state);
 void UiDrawStatusBar(Renderer &renderer, const UiState &state);
 void UiDrawTempStrip(Renderer &renderer, const UiState &state);
 void UiDrawListHeader(Renderer &renderer, const char *title);
-void UiDrawListRow(Renderer &renderer, int row, const char *label, const char *value, bool focused, bool editing);
+void UiDrawListRow(Renderer &renderer, int row, int index, const char *label, const char *value, bool focused, bool editing);
 void UiDrawContextMenu(Renderer &renderer, const UiContext &ctx);
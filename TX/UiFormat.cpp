@@ -0,0 +1,105 @@
+#include "UiFormat.h"
+
+namespace {
+static const int32_t kPow10[] = {1, 10, 100, 1000};
+
+// Appends the decimal digits of value, padded with zeros to minDigits.
+size_t appendDigits(char *buf, size_t size, size_t pos, uint32_t value, uint8_t minDigits) {
+  char digits[10];
+  uint8_t n = 0;
+  do {
+    digits[n++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (n < minDigits) digits[n++] = '0';
+  while (n > 0 && pos + 1 < size) buf[pos++] = digits[--n];
+  buf[pos] = '\0';
+  return pos;
+}
+
+size_t appendText(char *buf, size_t size, size_t pos, const char *str) {
+  if (str) {
+    while (*str && pos + 1 < size) buf[pos++] = *str++;
+  }
+  buf[pos] = '\0';
+  return pos;
+}
+
+int32_t quantize(float value, uint8_t decimals) {
+  float scaled = value * kPow10[decimals];
+  return static_cast<int32_t>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+
+size_t formatScaled(char *buf, size_t size, int32_t scaled, uint8_t decimals, const char *prefix,
+                    const char *suffix) {
+  if (size == 0) return 0;
+  size_t pos = appendText(buf, size, 0, prefix);
+  uint32_t mag = (scaled < 0) ? 0U - static_cast<uint32_t>(scaled) : static_cast<uint32_t>(scaled);
+  if (scaled < 0) pos = appendText(buf, size, pos, "-");
+  pos = appendDigits(buf, size, pos, mag / kPow10[decimals], 1);
+  if (decimals > 0) {
+    pos = appendText(buf, size, pos, ".");
+    pos = appendDigits(buf, size, pos, mag % kPow10[decimals], decimals);
+  }
+  return appendText(buf, size, pos, suffix);
+}
+
+uint8_t clampDecimals(uint8_t decimals) {
+  return decimals > 3 ? 3 : decimals;
+}
+}  // namespace
+
+namespace UiFormat {
+size_t text(char *buf, size_t size, const char *str) {
+  if (size == 0) return 0;
+  return appendText(buf, size, 0, str);
+}
+
+size_t integer(char *buf, size_t size, int32_t value, const char *prefix, const char *suffix) {
+  return formatScaled(buf, size, value, 0, prefix, suffix);
+}
+
+size_t unsignedInt(char *buf, size_t size, uint32_t value, const char *prefix, const char *suffix) {
+  if (size == 0) return 0;
+  size_t pos = appendText(buf, size, 0, prefix);
+  pos = appendDigits(buf, size, pos, value, 1);
+  return appendText(buf, size, pos, suffix);
+}
+
+size_t fixed(char *buf, size_t size, float value, uint8_t decimals, const char *prefix, const char *suffix) {
+  decimals = clampDecimals(decimals);
+  return formatScaled(buf, size, quantize(value, decimals), decimals, prefix, suffix);
+}
+
+size_t decimal(char *buf, size_t size, int32_t scaled, uint8_t decimals, const char *prefix, const char *suffix) {
+  return formatScaled(buf, size, scaled, clampDecimals(decimals), prefix, suffix);
+}
+
+bool Field::unchanged(int32_t value, uint8_t decimals, const char *prefix, const char *suffix) {
+  if (valid && value == lastValue && decimals == lastDecimals && prefix == lastPrefix && suffix == lastSuffix) {
+    return true;
+  }
+  valid = true;
+  lastValue = value;
+  lastDecimals = decimals;
+  lastPrefix = prefix;
+  lastSuffix = suffix;
+  return false;
+}
+
+const char *Field::integer(int32_t value, const char *prefix, const char *suffix) {
+  if (!unchanged(value, 0, prefix, suffix)) {
+    formatScaled(buf, sizeof(buf), value, 0, prefix, suffix);
+  }
+  return buf;
+}
+
+const char *Field::fixed(float value, uint8_t decimals, const char *prefix, const char *suffix) {
+  decimals = clampDecimals(decimals);
+  int32_t scaled = quantize(value, decimals);
+  if (!unchanged(scaled, decimals, prefix, suffix)) {
+    formatScaled(buf, sizeof(buf), scaled, decimals, prefix, suffix);
+  }
+  return buf;
+}
+}  // namespace UiFormat
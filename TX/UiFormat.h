@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Number formatting for draw paths without printf. Every writer fills a
+// caller buffer, always NUL-terminates it (truncating like snprintf) and
+// returns the length written, so calls can be chained into one buffer.
+namespace UiFormat {
+size_t text(char *buf, size_t size, const char *str);
+size_t integer(char *buf, size_t size, int32_t value, const char *prefix = nullptr, const char *suffix = nullptr);
+size_t unsignedInt(char *buf, size_t size, uint32_t value, const char *prefix = nullptr,
+                   const char *suffix = nullptr);
+// Rounds value to the given number of decimals (0-3): 7.46 with 1 -> "7.5".
+size_t fixed(char *buf, size_t size, float value, uint8_t decimals, const char *prefix = nullptr,
+             const char *suffix = nullptr);
+// Writes an already scaled value: 75 with 1 decimal -> "7.5".
+size_t decimal(char *buf, size_t size, int32_t scaled, uint8_t decimals, const char *prefix = nullptr,
+               const char *suffix = nullptr);
+inline size_t percent(char *buf, size_t size, int32_t value) {
+  return integer(buf, size, value, nullptr, "%");
+}
+
+// One on-screen number. Keeps the last text it produced and only formats
+// again when the value, at the displayed precision, or the affixes change.
+class Field {
+public:
+  const char *integer(int32_t value, const char *prefix = nullptr, const char *suffix = nullptr);
+  const char *fixed(float value, uint8_t decimals, const char *prefix = nullptr, const char *suffix = nullptr);
+
+private:
+  bool unchanged(int32_t value, uint8_t decimals, const char *prefix, const char *suffix);
+
+  char buf[16] = "";
+  int32_t lastValue = 0;
+  const char *lastPrefix = nullptr;
+  const char *lastSuffix = nullptr;
+  uint8_t lastDecimals = 0;
+  bool valid = false;
+};
+}  // namespace UiFormat
@@ -0,0 +1,89 @@
+#include "UiGauge.h"
+
+#include "FixedMath.h"
+
+namespace {
+const int16_t kCenter = UiGauge::kSize / 2;
+const int16_t kOuterR = kCenter - 2;
+const int16_t kInnerR = kOuterR - 5;
+const int16_t kNeedleR = kInnerR - 4;
+const int16_t kHubR = 3;
+const int16_t kStartDeg = 135;
+const int16_t kSweepDeg = 270;
+
+int16_t needleEnd(int32_t center, int32_t trig) {
+  return static_cast<int16_t>(center + FixedMath::floorDiv(trig * kNeedleR + FixedMath::kOne / 2, FixedMath::kOne));
+}
+}  // namespace
+
+UiGauge::UiGauge(int16_t minVal, int16_t maxVal, ColorToken background)
+    : minVal(minVal), maxVal(maxVal), background(background) {}
+
+int16_t UiGauge::angleFor(int16_t value) const {
+  if (value < minVal) value = minVal;
+  if (value > maxVal) value = maxVal;
+  int32_t span = maxVal - minVal;
+  return static_cast<int16_t>(kStartDeg + (span ? (static_cast<int32_t>(value - minVal) * kSweepDeg) / span : 0));
+}
+
+void UiGauge::draw(Renderer &renderer, int16_t x, int16_t y, int16_t value) {
+  int16_t deg = angleFor(value);
+  const Palette *palette = renderer.activePalette();
+  if (renderer.recording() || !palette) {
+    drawFull(renderer, x, y, deg);
+    return;
+  }
+
+  if (!valid || palette->revision() != paletteRevision) {
+    canvas.setBuffer(pixels, kSize, kSize, palette);
+    drawFull(canvas, 0, 0, deg);
+    valid = true;
+    paletteRevision = palette->revision();
+  } else if (deg != drawnDeg) {
+    // Ring angles are half-open, so repainting [old, new) with the colors
+    // of the new value leaves exactly what a full redraw would.
+    drawSweep(canvas, 0, 0, drawnDeg, deg, deg);
+    drawNeedle(canvas, 0, 0, drawnDeg, background);
+    drawNeedle(canvas, 0, 0, deg, TEXT_PRIMARY);
+  }
+  drawnDeg = deg;
+  renderer.blit(pixels, x, y, kSize, kSize);
+}
+
+void UiGauge::drawFull(Renderer &target, int16_t ox, int16_t oy, int16_t valueDeg) const {
+  target.fillRect(ox, oy, kSize, kSize, background);
+  drawSweep(target, ox, oy, kStartDeg, kStartDeg + kSweepDeg, valueDeg);
+  drawNeedle(target, ox, oy, valueDeg, TEXT_PRIMARY);
+}
+
+// Paints the ring over [from, to) in the colors it has at valueDeg: the
+// part between the zero angle and the value is filled, the rest is track.
+void UiGauge::drawSweep(Renderer &target, int16_t ox, int16_t oy, int16_t fromDeg, int16_t toDeg,
+                        int16_t valueDeg) const {
+  int16_t lo = (fromDeg < toDeg) ? fromDeg : toDeg;
+  int16_t hi = (fromDeg < toDeg) ? toDeg : fromDeg;
+  int16_t zeroDeg = angleFor(0);
+  int16_t fillLo = (zeroDeg < valueDeg) ? zeroDeg : valueDeg;
+  int16_t fillHi = (zeroDeg < valueDeg) ? valueDeg : zeroDeg;
+  ColorToken fill = (valueDeg > zeroDeg) ? BAR_POS : BAR_NEG;
+
+  // Split at the fill bounds so every piece has a single color.
+  int16_t cuts[4] = {lo, fillLo, fillHi, hi};
+  int16_t cx = ox + kCenter;
+  int16_t cy = oy + kCenter;
+  for (uint8_t i = 0; i < 3; ++i) {
+    int16_t a = (cuts[i] > lo) ? cuts[i] : lo;
+    int16_t b = (cuts[i + 1] < hi) ? cuts[i + 1] : hi;
+    if (a >= b) continue;
+    bool filled = a >= fillLo && b <= fillHi;
+    target.fillArc(cx, cy, kOuterR, kInnerR, a, b, filled ? fill : GRID_LINE);
+  }
+}
+
+void UiGauge::drawNeedle(Renderer &target, int16_t ox, int16_t oy, int16_t valueDeg, ColorToken color) const {
+  int16_t cx = ox + kCenter;
+  int16_t cy = oy + kCenter;
+  target.drawThickLine(cx, cy, needleEnd(cx, FixedMath::cosDeg(valueDeg)), needleEnd(cy, FixedMath::sinDeg(valueDeg)),
+                       3, color);
+  target.fillCircle(cx, cy, kHubR, ACCENT_CYAN);
+}
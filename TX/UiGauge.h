@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Renderer.h"
+
+// Analog gauge: a 270 degree ring that fills from the zero point towards
+// the value, with a needle in the middle. The gauge keeps its own
+// rasterized copy; when the value moves, only the ring between the old and
+// new angle is repainted and the needle redrawn, and the copy is blitted
+// into the frame. A recording renderer gets the full shape commands.
+class UiGauge {
+public:
+  static const int16_t kSize = 44;
+
+  UiGauge(int16_t minVal, int16_t maxVal, ColorToken background);
+
+  void draw(Renderer &renderer, int16_t x, int16_t y, int16_t value);
+
+private:
+  int16_t angleFor(int16_t value) const;
+  void drawFull(Renderer &target, int16_t ox, int16_t oy, int16_t valueDeg) const;
+  void drawSweep(Renderer &target, int16_t ox, int16_t oy, int16_t fromDeg, int16_t toDeg, int16_t valueDeg) const;
+  void drawNeedle(Renderer &target, int16_t ox, int16_t oy, int16_t valueDeg, ColorToken color) const;
+
+  int16_t minVal;
+  int16_t maxVal;
+  ColorToken background;
+  FramePixel pixels[kSize * kSize];
+  Renderer canvas;
+  bool valid = false;
+  uint16_t paletteRevision = 0;
+  int16_t drawnDeg = 0;
+};
@@ -0,0 +1,74 @@
+#include "UiMenu.h"
+
+#include "UiDraw.h"
+#include "UiFormat.h"
+#include "UiLayout.h"
+#include "UiStrings.h"
+
+const char *UiFmtInt(const UiItem &item, const UiState &, int32_t value, char *buf, size_t size) {
+  UiFormat::integer(buf, size, value, nullptr, item.text);
+  return buf;
+}
+
+const char *UiFmtOnOff(const UiItem &, const UiState &, int32_t value, char *, size_t) {
+  return UiStrings::onOffLabel(value != 0);
+}
+
+const char *UiFmtText(const UiItem &item, const UiState &, int32_t, char *, size_t) {
+  return item.text;
+}
+
+void UiMenuDraw(Renderer &renderer, ScreenId id, const UiScreenDesc &screen, const UiState &state,
+                const UiContext &ctx) {
+  if (screen.draw) {
+    screen.draw(renderer, state, ctx);
+    return;
+  }
+  UiMenuDrawList(renderer, id, screen, state, ctx);
+}
+
+void UiMenuDrawList(Renderer &renderer, ScreenId id, const UiScreenDesc &screen, const UiState &state,
+                    const UiContext &ctx) {
+  UiDrawListHeader(renderer, screen.title);
+  int visible = UiLayout::ListH / UiLayout::ItemH;
+  int start = ctx.scroll[id];
+  bool editing = !screen.directAdjust && ctx.editMode[id];
+  char buf[20];
+  for (int row = 0; row < visible; ++row) {
+    int idx = start + row;
+    if (idx >= screen.itemCount) break;
+    const UiItem &item = screen.items[idx];
+    const char *value = "";
+    if (item.format && UiDrawDynamic()) {
+      value = item.format(item, state, item.get ? item.get(state) : 0, buf, sizeof(buf));
+    }
+    UiDrawListRow(renderer, row, idx, item.label, value, idx == ctx.focus[id], editing);
+  }
+
+  if (screen.extra) {
+    screen.extra(renderer, state, ctx);
+  }
+}
+
+void UiMenuAdjust(const UiItem &item, int delta, UiState &state) {
+  if (!item.get || !item.set) return;
+  int32_t value = item.get(state);
+  switch (item.edit) {
+    case UI_EDIT_CLAMP:
+      value += delta * item.step;
+      if (value < item.minVal) value = item.minVal;
+      if (value > item.maxVal) value = item.maxVal;
+      break;
+    case UI_EDIT_WRAP: {
+      int32_t span = item.maxVal - item.minVal + 1;
+      value = item.minVal + ((value - item.minVal + delta) % span + span) % span;
+      break;
+    }
+    case UI_EDIT_TOGGLE:
+      value = value ? 0 : 1;
+      break;
+    default:
+      return;
+  }
+  item.set(state, value);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "InputManager.h"
+#include "Renderer.h"
+#include "Ui.h"
+#include "UiState.h"
+#include "UiTracker.h"
+
+// Screens are described by constant tables instead of per-screen switch
+// code. A list screen is a title plus an array of items; UiMenuDraw and
+// UiMenuAdjust render and edit any of them, and UiManager indexes the
+// descriptors by ScreenId. Custom screens supply their own draw/input hooks.
+
+struct UiItem;
+
+typedef int32_t (*UiGetter)(const UiState &state);
+typedef void (*UiSetter)(UiState &state, int32_t value);
+typedef const char *(*UiFormatter)(const UiItem &item, const UiState &state, int32_t value, char *buf, size_t size);
+typedef void (*UiAction)(UiState &state, UiContext &ctx, uint8_t index);
+typedef void (*UiDrawHook)(Renderer &renderer, const UiState &state, const UiContext &ctx);
+typedef void (*UiInputHook)(const InputActions &actions, UiState &state, UiContext &ctx);
+typedef bool (*UiLiveHook)(const UiContext &ctx);
+
+enum UiEdit : uint8_t {
+  UI_EDIT_NONE,
+  UI_EDIT_CLAMP,   // value + delta * step, clamped to [minVal, maxVal]
+  UI_EDIT_WRAP,    // value + delta, wrapping inside [minVal, maxVal]
+  UI_EDIT_TOGGLE
+};
+
+struct UiItem {
+  const char *label;
+  UiGetter get;
+  UiSetter set;
+  UiEdit edit;
+  int16_t minVal;
+  int16_t maxVal;
+  int16_t step;
+  UiFormatter format;  // nullptr: no value column
+  const char *text;    // suffix for numbers, fixed text for UiFmtText
+  UiAction action;     // SET on the item; nullptr toggles edit mode
+};
+
+// Content refresh intervals for UiScreenDesc::refreshMs. Navigation still
+// redraws at once; the interval only paces redraws driven by UiState.
+enum UiRefresh : uint16_t {
+  UI_REFRESH_60HZ = 16,
+  UI_REFRESH_30HZ = 33,
+  UI_REFRESH_10HZ = 100,
+  UI_REFRESH_5HZ = 200
+};
+
+struct UiScreenDesc {
+  const char *title;
+  const UiItem *items;
+  uint8_t itemCount;
+  uint16_t deps;       // UiDep groups the screen reads
+  uint16_t refreshMs;  // content region refresh interval (UiRefresh)
+  bool directAdjust;   // trim edits the focused item without edit mode
+  bool staticLayer;    // content can be cached as a static layer
+  UiDrawHook draw;     // replaces the list when set
+  UiDrawHook extra;    // drawn after the list rows
+  UiInputHook input;   // replaces list input when set
+  UiLiveHook live;     // redrawn at 60 Hz while true, e.g. scrolling graphs
+};
+
+#define UI_ITEM_COUNT(items) static_cast<uint8_t>(sizeof(items) / sizeof((items)[0]))
+
+template <typename T, T UiState::*field>
+int32_t UiFieldGet(const UiState &state) {
+  return static_cast<int32_t>(state.*field);
+}
+
+template <typename T, T UiState::*field>
+void UiFieldSet(UiState &state, int32_t value) {
+  state.*field = static_cast<T>(value);
+}
+
+// Accessors for a plain UiState member, e.g. UI_FIELD(gyroGain).
+#define UI_GET(name) UiFieldGet<decltype(UiState::name), &UiState::name>
+#define UI_SET(name) UiFieldSet<decltype(UiState::name), &UiState::name>
+#define UI_FIELD(name) UI_GET(name), UI_SET(name)
+
+const char *UiFmtInt(const UiItem &item, const UiState &state, int32_t value, char *buf, size_t size);
+const char *UiFmtOnOff(const UiItem &item, const UiState &state, int32_t value, char *buf, size_t size);
+const char *UiFmtText(const UiItem &item, const UiState &state, int32_t value, char *buf, size_t size);
+
+constexpr UiItem UiItemLabel(const char *label) {
+  return UiItem{label, nullptr, nullptr, UI_EDIT_NONE, 0, 0, 0, nullptr, nullptr, nullptr};
+}
+
+constexpr UiItem UiItemValue(const char *label, UiGetter get, UiFormatter format = UiFmtInt,
+                             const char *text = nullptr) {
+  return UiItem{label, get, nullptr, UI_EDIT_NONE, 0, 0, 0, format, text, nullptr};
+}
+
+constexpr UiItem UiItemRange(const char *label, UiGetter get, UiSetter set, int16_t minVal, int16_t maxVal,
+                             int16_t step = 1, const char *text = nullptr, UiFormatter format = UiFmtInt) {
+  return UiItem{label, get, set, UI_EDIT_CLAMP, minVal, maxVal, step, format, text, nullptr};
+}
+
+constexpr UiItem UiItemCycle(const char *label, UiGetter get, UiSetter set, int16_t count, UiFormatter format) {
+  return UiItem{label, get, set, UI_EDIT_WRAP, 0, static_cast<int16_t>(count - 1), 1, format, nullptr, nullptr};
+}
+
+constexpr UiItem UiItemToggle(const char *label, UiGetter get, UiSetter set, UiFormatter format = UiFmtOnOff,
+                              const char *text = nullptr) {
+  return UiItem{label, get, set, UI_EDIT_TOGGLE, 0, 1, 1, format, text, nullptr};
+}
+
+constexpr UiItem UiItemAction(const char *label, UiAction action, UiGetter get = nullptr,
+                              UiFormatter format = nullptr, const char *text = nullptr) {
+  return UiItem{label, get, nullptr, UI_EDIT_NONE, 0, 0, 0, format, text, action};
+}
+
+void UiMenuDraw(Renderer &renderer, ScreenId id, const UiScreenDesc &screen, const UiState &state,
+                const UiContext &ctx);
+// The list part of UiMenuDraw, for draw hooks that show the list in one view.
+void UiMenuDrawList(Renderer &renderer, ScreenId id, const UiScreenDesc &screen, const UiState &state,
+                    const UiContext &ctx);
+// Applies one trim step to an editable item; read-only items are ignored.
+void UiMenuAdjust(const UiItem &item, int delta, UiState &state);
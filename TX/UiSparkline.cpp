@@ -0,0 +1,82 @@
+#include "UiSparkline.h"
+
+UiSparkline::UiSparkline(int16_t minVal, int16_t maxVal, ColorToken trace, ColorToken background)
+    : minVal(minVal), maxVal(maxVal), trace(trace), background(background) {}
+
+uint8_t UiSparkline::rowFor(int16_t value) const {
+  if (value < minVal) value = minVal;
+  if (value > maxVal) value = maxVal;
+  int32_t span = maxVal - minVal;
+  int32_t above = span ? (static_cast<int32_t>(value - minVal) * (kH - 1) + span / 2) / span : 0;
+  return static_cast<uint8_t>(kH - 1 - above);
+}
+
+void UiSparkline::sample(int16_t value, uint32_t nowMs) {
+  uint8_t row = rowFor(value);
+  if (!sampled) {
+    // Start out flat at the first value.
+    for (int16_t i = 0; i < kW; ++i) {
+      spanTop[i] = row;
+      spanBottom[i] = row;
+    }
+    lastRow = row;
+    flatColumns = kW;
+    sampled = true;
+    lastSampleMs = nowMs;
+    valid = false;
+    return;
+  }
+
+  uint32_t steps = (nowMs - lastSampleMs) / kPeriodMs;
+  if (steps == 0) return;
+  lastSampleMs += steps * kPeriodMs;
+  if (steps > static_cast<uint32_t>(kW)) steps = kW;
+  while (steps-- > 0) {
+    push(row);
+  }
+}
+
+void UiSparkline::push(uint8_t row) {
+  // Every column already shows this row; scrolling would change nothing.
+  if (!moving() && row == lastRow) return;
+  spanTop[head] = (row < lastRow) ? row : lastRow;
+  spanBottom[head] = (row < lastRow) ? lastRow : row;
+  if (row == lastRow) {
+    if (flatColumns < kW) ++flatColumns;
+  } else {
+    flatColumns = 0;
+  }
+  lastRow = row;
+  if (valid) drawColumn(head);
+  head = (head + 1 == kW) ? 0 : head + 1;
+  ++revision;
+}
+
+void UiSparkline::drawColumn(int16_t col) {
+  canvas.drawVLine(col, 0, kH, background);
+  if (minVal < 0 && maxVal > 0) {
+    canvas.drawVLine(col, rowFor(0), 1, GRID_LINE);
+  }
+  canvas.drawVLine(col, spanTop[col], spanBottom[col] - spanTop[col] + 1, trace);
+}
+
+void UiSparkline::draw(Renderer &renderer, int16_t x, int16_t y) {
+  const Palette *palette = renderer.activePalette();
+  if (!sampled || !palette) return;
+  if (!valid || palette->revision() != paletteRevision) {
+    canvas.setBuffer(pixels, kW, kH, palette);
+    for (int16_t col = 0; col < kW; ++col) {
+      drawColumn(col);
+    }
+    valid = true;
+    paletteRevision = palette->revision();
+    ++revision;
+  }
+
+  // Columns [head, kW) are the oldest.
+  int16_t older = kW - head;
+  renderer.blit(pixels + head, x, y, older, kH, kW, revision);
+  if (head > 0) {
+    renderer.blit(pixels, x + older, y, head, kH, kW, revision);
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Renderer.h"
+
+// Scrolling time-series trace. Samples land in a ring of pixel columns:
+// each new one rasterizes a single column (background plus the vertical
+// span joining it to the previous sample) over the oldest, and draw()
+// blits the ring in two pieces so the oldest column comes out leftmost.
+// The work per sample and per frame does not grow with the history kept.
+class UiSparkline {
+public:
+  static const int16_t kW = 116;
+  static const int16_t kH = 22;
+  // One column per 60 Hz frame.
+  static const uint16_t kPeriodMs = 16;
+
+  UiSparkline(int16_t minVal, int16_t maxVal, ColorToken trace, ColorToken background);
+
+  // Holds value for every period elapsed since the previous sample, so
+  // frames that were skipped or drawn late keep the time axis even.
+  void sample(int16_t value, uint32_t nowMs);
+  void draw(Renderer &renderer, int16_t x, int16_t y);
+  // False once the trace has been flat for the whole width, when
+  // scrolling it further would not change a pixel.
+  bool moving() const { return flatColumns < kW; }
+
+private:
+  uint8_t rowFor(int16_t value) const;
+  void push(uint8_t row);
+  void drawColumn(int16_t col);
+
+  int16_t minVal;
+  int16_t maxVal;
+  ColorToken trace;
+  ColorToken background;
+  FramePixel pixels[kW * kH];
+  Renderer canvas;
+  // Trace span of every column, so the ring can be redrawn in new colors.
+  uint8_t spanTop[kW];
+  uint8_t spanBottom[kW];
+  int16_t head = 0;  // column the next sample goes to
+  uint8_t lastRow = 0;
+  int16_t flatColumns = 0;
+  bool sampled = false;
+  uint32_t lastSampleMs = 0;
+  bool valid = false;
+  uint16_t paletteRevision = 0;
+  uint16_t revision = 0;
+};
@@ -100,6 +100,10 @@ struct UiState {
   uint16_t fps = 0;
   uint8_t cpuLoad = 30;
   uint32_t memFree = 0;
+  uint32_t textCacheHits = 0;
+  uint32_t textCacheMisses = 0;
+  uint16_t textCacheBytes = 0;
+  uint16_t textCacheSize = 0;
 
   uint16_t peakTemp = 72;
   uint16_t maxSpeed = 88;
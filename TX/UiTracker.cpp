@@ -0,0 +1,153 @@
+#include "UiTracker.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace {
+struct TrackedField {
+  uint16_t offset;
+  uint8_t size;
+  int8_t decimals;  // <0: compare bytes; else a float shown with this many decimals
+  uint16_t group;
+};
+
+#define TRACK(name, group) {offsetof(UiState, name), sizeof(UiState::name), -1, group}
+#define TRACK_FLOAT(name, decimals, group) {offsetof(UiState, name), sizeof(float), decimals, group}
+
+constexpr TrackedField kFields[] = {
+  TRACK_FLOAT(steerPct, 0, UI_DEP_CONTROLS),
+  TRACK_FLOAT(throttlePct, 0, UI_DEP_CONTROLS),
+  TRACK_FLOAT(suspensionPct, 0, UI_DEP_CONTROLS),
+  TRACK_FLOAT(speedKmh, 0, UI_DEP_CONTROLS),
+  TRACK(gyroOn, UI_DEP_GYRO),
+  TRACK(gyroOverride, UI_DEP_SETTINGS),
+  TRACK(rxConnected, UI_DEP_LINK),
+
+  TRACK(rawSteer, UI_DEP_RAW),
+  TRACK(rawThrottle, UI_DEP_RAW),
+  TRACK(rawSuspension, UI_DEP_RAW),
+  TRACK(btnMenu, UI_DEP_RAW),
+  TRACK(btnSet, UI_DEP_RAW),
+  TRACK(btnTrimPlus, UI_DEP_RAW),
+  TRACK(btnTrimMinus, UI_DEP_RAW),
+
+  TRACK_FLOAT(txVoltage, 1, UI_DEP_POWER),
+  TRACK_FLOAT(rxVoltage, 1, UI_DEP_POWER),
+  TRACK(rxVoltageAvailable, UI_DEP_POWER),
+
+  TRACK_FLOAT(tempMotor, 0, UI_DEP_TEMPS),
+  TRACK_FLOAT(tempEsc, 0, UI_DEP_TEMPS),
+  TRACK_FLOAT(tempBoard, 0, UI_DEP_TEMPS),
+
+  TRACK_FLOAT(rpmEstimate, 0, UI_DEP_TELEMETRY),
+  TRACK_FLOAT(currentA, 0, UI_DEP_TELEMETRY),
+  TRACK_FLOAT(signalStrength, 0, UI_DEP_TELEMETRY),
+  TRACK_FLOAT(latencyMs, 0, UI_DEP_TELEMETRY),
+
+  TRACK(steerTrim, UI_DEP_SETTINGS),
+  TRACK(throttleTrim, UI_DEP_SETTINGS),
+  TRACK(trimPerProfile, UI_DEP_SETTINGS),
+  TRACK(headlights, UI_DEP_SETTINGS),
+  TRACK(taillights, UI_DEP_SETTINGS),
+  TRACK(turnSignals, UI_DEP_SETTINGS),
+  TRACK(brakeLights, UI_DEP_SETTINGS),
+  TRACK(auxOutput, UI_DEP_SETTINGS),
+  TRACK(accessoryMap, UI_DEP_SETTINGS),
+  TRACK(gyroGain, UI_DEP_SETTINGS),
+  TRACK(gyroMode, UI_DEP_SETTINGS),
+  TRACK(gyroResponse, UI_DEP_SETTINGS),
+  TRACK(steerDeadzone, UI_DEP_SETTINGS),
+  TRACK(steerCenter, UI_DEP_SETTINGS),
+  TRACK(steerExpo, UI_DEP_SETTINGS),
+  TRACK(steerEndpoint, UI_DEP_SETTINGS),
+  TRACK(throttleDeadzone, UI_DEP_SETTINGS),
+  TRACK(throttleCenter, UI_DEP_SETTINGS),
+  TRACK(throttleCurve, UI_DEP_SETTINGS),
+  TRACK(brakeStrength, UI_DEP_SETTINGS),
+  TRACK(reverseLogic, UI_DEP_SETTINGS),
+  TRACK(suspensionMode, UI_DEP_SETTINGS),
+  TRACK(suspensionPotMap, UI_DEP_SETTINGS),
+  TRACK(suspensionSpeedLogic, UI_DEP_SETTINGS),
+  TRACK(suspensionPreset, UI_DEP_SETTINGS),
+  TRACK(activeProfile, UI_DEP_SETTINGS),
+  TRACK(autoLoadProfile, UI_DEP_SETTINGS),
+  TRACK_FLOAT(txVoltageWarn, 1, UI_DEP_SETTINGS),
+  TRACK_FLOAT(rxVoltageWarn, 1, UI_DEP_SETTINGS),
+  TRACK(voltageSagDetect, UI_DEP_SETTINGS),
+  TRACK(failsafeMode, UI_DEP_SETTINGS),
+  TRACK(throttleCut, UI_DEP_SETTINGS),
+  TRACK(steeringCenter, UI_DEP_SETTINGS),
+  TRACK(alertSignal, UI_DEP_SETTINGS),
+  TRACK(alertTemp, UI_DEP_SETTINGS),
+  TRACK(alertVoltage, UI_DEP_SETTINGS),
+  TRACK(buzzerVolume, UI_DEP_SETTINGS),
+  TRACK(buzzerMute, UI_DEP_SETTINGS),
+  TRACK(displayBrightness, UI_DEP_SETTINGS),
+  TRACK(sleepTimeoutSec, UI_DEP_SETTINGS),
+  TRACK(ledMode, UI_DEP_SETTINGS),
+  TRACK(bootMode, UI_DEP_SETTINGS),
+
+  TRACK(loopTimeUs, UI_DEP_PERF),
+  TRACK(fps, UI_DEP_PERF),
+  TRACK(cpuLoad, UI_DEP_PERF),
+  TRACK(memFree, UI_DEP_PERF),
+  TRACK(textCacheHits, UI_DEP_PERF),
+  TRACK(textCacheMisses, UI_DEP_PERF),
+  TRACK(textCacheBytes, UI_DEP_PERF),
+  TRACK(textCacheSize, UI_DEP_PERF),
+
+  TRACK(peakTemp, UI_DEP_LOG),
+  TRACK(maxSpeed, UI_DEP_LOG),
+  TRACK(driveTimeSec, UI_DEP_LOG),
+  TRACK(errorCount, UI_DEP_LOG),
+
+  TRACK(wizardStep, UI_DEP_DIAG),
+
+  TRACK(linkQuality, UI_DEP_LINK),
+  TRACK(packetLoss, UI_DEP_LINK),
+  TRACK(updateRate, UI_DEP_LINK),
+  TRACK(reconnectEnabled, UI_DEP_SETTINGS),
+
+  TRACK(sensorsHealthy, UI_DEP_DIAG),
+  TRACK(gyroValid, UI_DEP_DIAG),
+  TRACK(adcSanity, UI_DEP_DIAG),
+
+  TRACK(expertMode, UI_DEP_SETTINGS),
+  TRACK(experimental, UI_DEP_SETTINGS),
+  TRACK(perfOverride, UI_DEP_SETTINGS),
+};
+
+#undef TRACK
+#undef TRACK_FLOAT
+
+static const float kHalfSteps[] = {2.0f, 20.0f, 200.0f};
+
+int32_t halfSteps(const uint8_t *base, const TrackedField &field) {
+  float value;
+  memcpy(&value, base + field.offset, sizeof(value));
+  return static_cast<int32_t>(floorf(value * kHalfSteps[field.decimals]));
+}
+}  // namespace
+
+uint16_t UiStateTracker::update(const UiState &state) {
+  uint16_t changed = UI_DEP_ALL;
+  if (valid) {
+    changed = 0;
+    const uint8_t *cur = reinterpret_cast<const uint8_t *>(&state);
+    const uint8_t *old = reinterpret_cast<const uint8_t *>(&shadow);
+    for (const TrackedField &field : kFields) {
+      if (changed & field.group) continue;
+      bool same = (field.decimals < 0) ? memcmp(cur + field.offset, old + field.offset, field.size) == 0
+                                       : halfSteps(cur, field) == halfSteps(old, field);
+      if (!same) changed |= field.group;
+    }
+  }
+  shadow = state;
+  valid = true;
+
+  for (uint8_t i = 0; i < kGroups; ++i) {
+    if (changed & (1U << i)) versions[i]++;
+  }
+  return changed;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "UiState.h"
+
+// UiState fields are grouped by what tends to change together. Screens
+// declare the groups they read, so a frame only has to be drawn when one
+// of those groups moved since the last render.
+enum UiDep : uint16_t {
+  UI_DEP_CONTROLS = 1 << 0,   // steer/throttle/suspension percent, speed
+  UI_DEP_RAW = 1 << 1,        // raw ADC readings and buttons
+  UI_DEP_GYRO = 1 << 2,       // effective gyro state
+  UI_DEP_POWER = 1 << 3,      // battery voltages
+  UI_DEP_TEMPS = 1 << 4,
+  UI_DEP_TELEMETRY = 1 << 5,  // rpm, current, signal, latency
+  UI_DEP_LINK = 1 << 6,
+  UI_DEP_SETTINGS = 1 << 7,   // everything the user edits
+  UI_DEP_PERF = 1 << 8,
+  UI_DEP_LOG = 1 << 9,
+  UI_DEP_DIAG = 1 << 10,
+  UI_DEP_ALL = 0x07FF
+};
+
+// Detects UiState changes without touching the code that writes the state:
+// update() compares every tracked field against a private copy and bumps
+// the version of each group with a changed field. Floats are compared at
+// half their displayed resolution, so both truncated and rounded values
+// are covered while sub-display noise is ignored.
+class UiStateTracker {
+public:
+  static const uint8_t kGroups = 11;
+
+  // Returns the mask of groups that changed since the previous call.
+  uint16_t update(const UiState &state);
+  uint16_t version(uint8_t group) const { return versions[group]; }
+
+private:
+  UiState shadow;
+  bool valid = false;
+  uint16_t versions[kGroups] = {0};
+};
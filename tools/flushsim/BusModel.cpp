@@ -0,0 +1,175 @@
+#include "BusModel.h"
+
+#include <driver/spi_master.h>
+
+#include "HardwareConfig.h"
+#include "Host.h"
+#include "PanelRam.h"
+
+namespace {
+struct Pending {
+  spi_transaction_t *trans;
+  uint64_t doneNs;
+  bool delivered;
+};
+
+// Larger than any queue_size PanelIO asks for.
+const int kMaxQueue = 32;
+
+BusModel::Config config;
+BusModel::FrameSink sink = nullptr;
+spi_device_interface_config_t device;
+
+// Queued transactions not yet collected, oldest first.
+Pending pending[kMaxQueue];
+int pendingCount = 0;
+uint64_t busFreeNs = 0;
+
+BusModel::Frame frame;
+
+bool inPreTransfer = false;
+uint32_t dcWritesOnBus = 0;
+
+// DC changed by anyone but the pre-transfer callback while a transaction
+// may be on the wire: on the board that byte goes out with the wrong level.
+void watchDc(int pin, int) {
+  if (pin != PIN_TFT_DC || inPreTransfer) return;
+  if (pendingCount > 0 || busFreeNs > Host::nowNs()) dcWritesOnBus++;
+}
+
+// Clocks a transaction into the panel: the pre-transfer callback sets DC
+// as the driver calls it right before the bytes go out, and the panel
+// takes them at whatever level the pin then has. Queued transactions are
+// read when they are collected, the last moment PanelIO's buffers are
+// guaranteed untouched.
+void deliver(spi_transaction_t *trans) {
+  if (device.pre_cb) {
+    inPreTransfer = true;
+    device.pre_cb(trans);
+    inPreTransfer = false;
+  }
+  const uint8_t *bytes = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data
+                                                                : static_cast<const uint8_t *>(trans->tx_buffer);
+  PanelRam::receive(Host::pinLevel(PIN_TFT_DC) != 0, bytes, trans->length / 8);
+}
+
+// Transactions queued ahead of a blocking one are on the wire before it.
+void deliverQueued() {
+  for (int i = 0; i < pendingCount; ++i) {
+    if (pending[i].delivered) continue;
+    deliver(pending[i].trans);
+    pending[i].delivered = true;
+  }
+}
+
+// Puts one transaction on the bus after everything already there and
+// returns when it is done.
+uint64_t schedule(const spi_transaction_t *trans, uint32_t setupNs) {
+  uint64_t now = Host::nowNs();
+  uint64_t start = (busFreeNs > now) ? busFreeNs : now;
+  uint32_t bytes = static_cast<uint32_t>(trans->length / 8);
+  uint64_t wireNs = static_cast<uint64_t>(bytes) * 8 * 1000000000ull / device.clock_speed_hz;
+  uint64_t duration = setupNs + wireNs;
+
+  if (frame.transactions == 0) frame.startNs = start;
+  frame.endNs = start + duration;
+  frame.busyNs += duration;
+  frame.setupNs += setupNs;
+  frame.transactions++;
+  frame.bytes += bytes;
+
+  busFreeNs = start + duration;
+  return busFreeNs;
+}
+}  // namespace
+
+namespace BusModel {
+void configure(const Config &newConfig) {
+  config = newConfig;
+}
+
+void setFrameSink(FrameSink newSink) {
+  sink = newSink;
+}
+
+uint32_t clockHz() {
+  return device.clock_speed_hz;
+}
+
+int queueDepth() {
+  return device.queue_size;
+}
+
+void beginFrame() {
+  endFrame();
+}
+
+void endFrame() {
+  if (frame.transactions > 0 && sink) sink(frame);
+  frame = Frame();
+}
+
+void discardFrame() {
+  frame = Frame();
+}
+
+uint32_t dcWritesDuringTransfers() {
+  return dcWritesOnBus;
+}
+}  // namespace BusModel
+
+esp_err_t spi_bus_initialize(int host, const spi_bus_config_t *busConfig, int dmaChannel) {
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(int host, const spi_device_interface_config_t *deviceConfig, spi_device_handle_t *handle) {
+  device = *deviceConfig;
+  if (device.queue_size > kMaxQueue) device.queue_size = kMaxQueue;
+  *handle = reinterpret_cast<spi_device_handle_t>(&device);
+  Host::watchPins(watchDc);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait) {
+  if (pendingCount >= device.queue_size) {
+    if (wait == 0 || pendingCount == kMaxQueue) return ESP_ERR_TIMEOUT;
+    // Blocks until the oldest leaves the queue; it waits for collection
+    // in the driver's result queue meanwhile.
+    Host::advanceTo(pending[pendingCount - device.queue_size].doneNs);
+  }
+  Pending &slot = pending[pendingCount++];
+  slot.trans = trans;
+  slot.delivered = false;
+  slot.doneNs = schedule(trans, config.queuedSetupNs);
+  if (pendingCount > frame.maxQueued) frame.maxQueued = static_cast<uint8_t>(pendingCount);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t wait) {
+  if (pendingCount == 0) return ESP_ERR_TIMEOUT;
+  if (pending[0].doneNs > Host::nowNs()) {
+    if (wait == 0) return ESP_ERR_TIMEOUT;
+    Host::advanceTo(pending[0].doneNs);
+  }
+  *trans = pending[0].trans;
+  if (!pending[0].delivered) deliver(*trans);
+  --pendingCount;
+  for (int i = 0; i < pendingCount; ++i) {
+    pending[i] = pending[i + 1];
+  }
+  return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans) {
+  deliverQueued();
+  deliver(trans);
+  Host::advanceTo(schedule(trans, config.queuedSetupNs));
+  return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans) {
+  deliverQueued();
+  deliver(trans);
+  Host::advanceTo(schedule(trans, config.polledSetupNs));
+  return ESP_OK;
+}
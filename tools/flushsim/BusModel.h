@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+
+// Timing model behind the host build of PanelIO. It implements the ESP-IDF
+// SPI master calls PanelIO makes: every transaction occupies the bus for a
+// fixed setup time (chip select, DMA descriptor load, the pre-transfer
+// callback that drives DC, the completion interrupt) plus its bits at the
+// device clock. Queued transactions start back to back while PanelIO keeps
+// the queue fed; the queue holds at most the device's queue_size, so when
+// the sketch is busy elsewhere the bus idles. Blocking calls move the
+// simulated clock to when the transfer ends.
+//
+// Every transaction also reaches the panel model in PanelRam: the device's
+// pre-transfer callback runs first, and the bytes land as command or data
+// by the level it left on DC.
+//
+// Totals are kept per frame: a frame starts at beginFrame() and takes every
+// transaction until the next one.
+namespace BusModel {
+struct Config {
+  // Defaults are ESP-IDF's figures for back-to-back ESP32 transactions.
+  uint32_t queuedSetupNs = 13000;
+  uint32_t polledSetupNs = 2000;
+};
+
+struct Frame {
+  uint64_t startNs = 0;     // first transaction starts
+  uint64_t endNs = 0;       // last transaction done
+  uint64_t busyNs = 0;      // bus occupied, setup included
+  uint64_t setupNs = 0;
+  uint32_t transactions = 0;
+  uint32_t bytes = 0;
+  uint8_t maxQueued = 0;
+
+  // Time the bus sat idle between the first and the last transaction,
+  // waiting for the sketch to queue more.
+  uint64_t stallNs() const { return (endNs - startNs) - busyNs; }
+};
+
+typedef void (*FrameSink)(const Frame &frame);
+
+void configure(const Config &config);
+// Called with every frame once it has ended.
+void setFrameSink(FrameSink sink);
+
+// Device settings as PanelIO configured them.
+uint32_t clockHz();
+int queueDepth();
+
+void beginFrame();
+// Closes the current frame, if it has any transactions.
+void endFrame();
+// Drops the current frame, e.g. the panel init before the session starts.
+void discardFrame();
+
+// Writes to the DC pin from outside the pre-transfer callback while the
+// bus was busy.
+uint32_t dcWritesDuringTransfers();
+}  // namespace BusModel
@@ -0,0 +1,200 @@
+#include "Host.h"
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <driver/gpio.h>
+#include <stdarg.h>
+
+HostSerial Serial;
+HostEsp ESP;
+
+namespace {
+// Nominal CPU clock, for getCycleCount().
+const uint32_t kCpuMhz = 240;
+const uint32_t kFreeHeap = 160000;
+
+// Arduino-ESP32 gives Serial no software TX buffer by default, only the
+// UART FIFO.
+const uint32_t kUartFifo = 128;
+
+uint64_t now = 0;
+bool pressed[Host::kPinCount];
+uint16_t analog[Host::kPinCount];
+uint8_t level[Host::kPinCount];
+Host::PinWatch pinWatch = nullptr;
+
+FILE *serialOut = nullptr;
+uint32_t uartRoom = kUartFifo;
+uint32_t uartBaud = 115200;
+uint32_t uartQueued = 0;
+uint64_t uartDrainedNs = 0;
+
+// 8N1: ten bit times per byte.
+uint64_t byteNs() {
+  return 10ull * 1000000000ull / uartBaud;
+}
+
+void drainUart() {
+  uint64_t bytes = (now - uartDrainedNs) / byteNs();
+  if (bytes >= uartQueued) {
+    uartQueued = 0;
+    uartDrainedNs = now;
+  } else {
+    uartQueued -= static_cast<uint32_t>(bytes);
+    uartDrainedNs += bytes * byteNs();
+  }
+}
+
+void uartWrite(const uint8_t *data, size_t len) {
+  if (serialOut) fwrite(data, 1, len, serialOut);
+  for (size_t i = 0; i < len; ++i) {
+    drainUart();
+    if (uartQueued == uartRoom) {
+      now = uartDrainedNs + byteNs();
+      drainUart();
+    }
+    uartQueued++;
+  }
+}
+
+bool validPin(int pin) {
+  return pin >= 0 && static_cast<uint32_t>(pin) < Host::kPinCount;
+}
+
+void writePin(int pin, int value) {
+  if (!validPin(pin)) return;
+  level[pin] = value ? HIGH : LOW;
+  if (pinWatch) pinWatch(pin, level[pin]);
+}
+}  // namespace
+
+namespace Host {
+uint64_t nowNs() {
+  return now;
+}
+
+void advanceTo(uint64_t ns) {
+  if (ns > now) now = ns;
+}
+
+void advanceBy(uint64_t ns) {
+  now += ns;
+}
+
+void setPressed(int pin, bool down) {
+  if (validPin(pin)) pressed[pin] = down;
+}
+
+void setAnalog(int pin, uint16_t value) {
+  if (validPin(pin)) analog[pin] = value;
+}
+
+int pinLevel(int pin) {
+  return validPin(pin) ? level[pin] : LOW;
+}
+
+void watchPins(PinWatch watch) {
+  pinWatch = watch;
+}
+
+void setSerialOutput(FILE *out) {
+  serialOut = out;
+}
+}  // namespace Host
+
+uint32_t millis() {
+  return static_cast<uint32_t>(now / 1000000);
+}
+
+uint32_t micros() {
+  return static_cast<uint32_t>(now / 1000);
+}
+
+void delay(uint32_t ms) {
+  now += static_cast<uint64_t>(ms) * 1000000;
+}
+
+void pinMode(int pin, int mode) {}
+
+int digitalRead(int pin) {
+  return (validPin(pin) && pressed[pin]) ? LOW : HIGH;
+}
+
+void digitalWrite(int pin, int value) {
+  writePin(pin, value);
+}
+
+int analogRead(int pin) {
+  return validPin(pin) ? analog[pin] : 0;
+}
+
+void analogReadResolution(int bits) {}
+
+int gpio_set_level(gpio_num_t pin, uint32_t value) {
+  writePin(pin, static_cast<int>(value));
+  return 0;
+}
+
+void HostSerial::setTxBufferSize(size_t size) {
+  uartRoom = kUartFifo + static_cast<uint32_t>(size);
+}
+
+void HostSerial::begin(unsigned long baud) {
+  uartBaud = baud;
+  uartQueued = 0;
+  uartDrainedNs = now;
+}
+
+size_t HostSerial::print(const char *text) {
+  return write(reinterpret_cast<const uint8_t *>(text), strlen(text));
+}
+
+size_t HostSerial::println(const char *text) {
+  return print(text) + write('\n');
+}
+
+size_t HostSerial::printf(const char *format, ...) {
+  char text[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  if (len <= 0) return 0;
+  if (len >= static_cast<int>(sizeof(text))) len = sizeof(text) - 1;
+  return write(reinterpret_cast<const uint8_t *>(text), len);
+}
+
+size_t HostSerial::write(uint8_t byte) {
+  return write(&byte, 1);
+}
+
+size_t HostSerial::write(const uint8_t *data, size_t len) {
+  uartWrite(data, len);
+  return len;
+}
+
+int HostSerial::availableForWrite() {
+  drainUart();
+  return uartRoom - uartQueued;
+}
+
+uint32_t HostEsp::getFreeHeap() {
+  return kFreeHeap;
+}
+
+uint32_t HostEsp::getCycleCount() {
+  return static_cast<uint32_t>(now / 1000 * kCpuMhz);
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+  // DMA-capable memory is word aligned on the ESP32.
+  return aligned_alloc(4, (size + 3) & ~static_cast<size_t>(3));
+}
+
+void heap_caps_free(void *ptr) {
+  free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+  return kFreeHeap;
+}
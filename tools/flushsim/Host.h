@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Simulated ESP32 surroundings for the sketch: a clock that only moves when
+// the simulation says so, and the pins a session drives.
+namespace Host {
+static const uint32_t kPinCount = 40;
+
+// Simulated time since boot.
+uint64_t nowNs();
+void advanceTo(uint64_t ns);
+void advanceBy(uint64_t ns);
+
+// Buttons read LOW while pressed; analog pins return 12-bit counts.
+void setPressed(int pin, bool pressed);
+void setAnalog(int pin, uint16_t value);
+
+// Output pins hold the level last written by digitalWrite() or
+// gpio_set_level(); the watcher, if set, sees every write.
+typedef void (*PinWatch)(int pin, int level);
+int pinLevel(int pin);
+void watchPins(PinWatch watch);
+
+// The serial port drains at the baud rate the sketch opened it with,
+// through the UART's 128-byte FIFO and any TX buffer the sketch asked for;
+// writes that do not fit wait for room, as on the board. Whatever the sketch writes is copied to out, if set.
+void setSerialOutput(FILE *out);
+}  // namespace Host
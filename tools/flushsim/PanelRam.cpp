@@ -0,0 +1,168 @@
+#include "PanelRam.h"
+
+#include "PanelDriver.h"
+
+namespace {
+// MADCTL's MX mirrors the columns for writes and scan alike, so it cancels
+// out here; MV (row/column exchange) is not modeled.
+static const uint8_t kMadctlMy = 0x80;
+static const int16_t kCols = PanelModel::kColOffset + PanelModel::kWidth;
+static const int16_t kRows = PanelModel::kMemoryRows;
+
+// Indexed by physical line: the order the controller scans, which MY
+// reverses against the row addresses.
+uint16_t memory[kRows][kCols];
+bool initialized = false;
+
+uint8_t command = 0;
+bool haveCommand = false;
+uint8_t args[6];
+uint8_t argCount = 0;
+uint32_t stray = 0;
+
+uint8_t madctl = 0;
+uint16_t colStart = 0, colEnd = 0, rowStart = 0, rowEnd = 0;
+uint16_t col = 0, row = 0;
+bool writing = false;
+bool highByteHeld = false;
+uint8_t highByte = 0;
+
+bool scrolling = false;
+uint16_t fixedTop = 0, scrollRows = kRows, scrollStart = 0;
+
+uint16_t word(const uint8_t *p) {
+  return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+int16_t physicalLine(int16_t y) {
+  return (madctl & kMadctlMy) ? kRows - 1 - y : y;
+}
+
+void initialize() {
+  for (int16_t y = 0; y < kRows; ++y) {
+    for (int16_t x = 0; x < kCols; ++x) {
+      memory[y][x] = PanelRam::kUnwritten;
+    }
+  }
+  initialized = true;
+}
+
+// Arguments the commands PanelIO sends take; -1 for commands this model
+// does not know, which take whatever follows.
+int argsFor(uint8_t cmd) {
+  switch (cmd) {
+    case 0x01:  // SWRESET
+    case 0x11:  // SLPOUT
+    case 0x13:  // NORON
+    case 0x29:  // DISPON
+      return 0;
+    case 0x36:  // MADCTL
+    case 0x3A:  // COLMOD
+      return 1;
+    case 0x37:  // VSCRSADD
+      return 2;
+    case 0x2A:  // CASET
+    case 0x2B:  // RASET
+      return 4;
+    case 0x33:  // VSCRDEF
+      return 6;
+    default:
+      return -1;
+  }
+}
+
+void writePixel(uint16_t value) {
+  if (col < kCols && row < kRows) memory[physicalLine(row)][col] = value;
+  if (++col > colEnd) {
+    col = colStart;
+    if (++row > rowEnd) row = rowStart;
+  }
+}
+
+void takeArgs() {
+  switch (command) {
+    case 0x2A:
+      colStart = word(args);
+      colEnd = word(args + 2);
+      break;
+    case 0x2B:
+      rowStart = word(args);
+      rowEnd = word(args + 2);
+      break;
+    case 0x33:
+      fixedTop = word(args);
+      scrollRows = word(args + 2);
+      break;
+    case 0x36:
+      madctl = args[0];
+      break;
+    case 0x37:
+      scrollStart = word(args);
+      scrolling = true;
+      break;
+  }
+}
+
+void beginCommand(uint8_t cmd) {
+  command = cmd;
+  haveCommand = true;
+  argCount = 0;
+  writing = (cmd == 0x2C);
+  highByteHeld = false;
+  if (writing) {
+    col = colStart;
+    row = rowStart;
+  }
+  if (cmd == 0x13) scrolling = false;
+}
+
+void dataByte(uint8_t b) {
+  if (writing) {
+    if (highByteHeld) {
+      writePixel(static_cast<uint16_t>((highByte << 8) | b));
+    } else {
+      highByte = b;
+    }
+    highByteHeld = !highByteHeld;
+    return;
+  }
+  int expected = haveCommand ? argsFor(command) : 0;
+  if (expected < 0) return;
+  if (argCount >= expected) {
+    stray++;
+    return;
+  }
+  args[argCount++] = b;
+  if (argCount == expected) takeArgs();
+}
+}  // namespace
+
+namespace PanelRam {
+void receive(bool data, const uint8_t *bytes, size_t len) {
+  if (!initialized) initialize();
+  for (size_t i = 0; i < len; ++i) {
+    if (data) {
+      dataByte(bytes[i]);
+    } else {
+      beginCommand(bytes[i]);
+    }
+  }
+}
+
+uint16_t shown(int16_t x, int16_t y) {
+  if (!initialized) initialize();
+  if (x < 0 || x >= kCols || y < 0 || y >= kRows) return kUnwritten;
+  // VSCRSADD names the memory line shown at the top of the scroll area;
+  // the lines below it follow and wrap within the area.
+  int16_t line = physicalLine(y);
+  if (scrolling && line >= fixedTop && line < fixedTop + scrollRows) {
+    line = static_cast<int16_t>(scrollStart + (line - fixedTop));
+    if (line >= fixedTop + scrollRows) line = static_cast<int16_t>(line - scrollRows);
+  }
+  return (line >= 0 && line < kRows) ? memory[line][x] : kUnwritten;
+}
+
+uint32_t strayBytes() {
+  return stray;
+}
+}  // namespace PanelRam
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The panel controller's side of the bus: BusModel feeds it every byte in
+// wire order with the DC level the byte was clocked in with, and it keeps
+// the controller's frame memory. It follows CASET/RASET/RAMWR, the
+// vertical scroll commands and MADCTL's row order; other commands and
+// their arguments are taken and ignored. Memory starts out as kUnwritten,
+// as undefined as the real controller's after power-up.
+namespace PanelRam {
+static const uint16_t kUnwritten = 0xDEAD;
+
+void receive(bool data, const uint8_t *bytes, size_t len);
+
+// Pixel the glass shows at controller column x and row y (the addresses
+// CASET/RASET take), after scrolling, in wire order: high byte first.
+uint16_t shown(int16_t x, int16_t y);
+
+// Data bytes past the arguments of a command whose count is known, or
+// before any command.
+uint32_t strayBytes();
+}  // namespace PanelRam
@@ -0,0 +1,57 @@
+#include "Session.h"
+
+#include <stdio.h>
+
+#include "HardwareConfig.h"
+#include "Host.h"
+
+namespace {
+const uint32_t kSettleMs = 1000;
+
+const int kAdcPins[3] = {PIN_STEERING, PIN_THROTTLE, PIN_POT_SUSPENSION};
+// Button bits in recording order.
+const int kButtonPins[5] = {PIN_BTN_MENU, PIN_BTN_SET, PIN_BTN_TRIM_PLUS, PIN_BTN_TRIM_MINUS, PIN_SW_GYRO};
+}  // namespace
+
+bool Session::load(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (!file) return false;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    unsigned long ms;
+    unsigned steer, throttle, suspension, buttons;
+    if (sscanf(line, "I %lu %u %u %u %u", &ms, &steer, &throttle, &suspension, &buttons) != 5) continue;
+    Event event;
+    event.ms = static_cast<uint32_t>(ms);
+    event.adc[0] = static_cast<uint16_t>(steer);
+    event.adc[1] = static_cast<uint16_t>(throttle);
+    event.adc[2] = static_cast<uint16_t>(suspension);
+    event.buttons = static_cast<uint8_t>(buttons);
+    events.push_back(event);
+  }
+  fclose(file);
+
+  if (events.empty()) return false;
+  uint32_t first = events[0].ms;
+  for (size_t i = 0; i < events.size(); ++i) {
+    events[i].ms -= first;
+  }
+  next = 0;
+  return true;
+}
+
+void Session::apply(uint32_t ms) {
+  while (next < events.size() && events[next].ms <= ms) {
+    const Event &event = events[next++];
+    for (int i = 0; i < 3; ++i) {
+      Host::setAnalog(kAdcPins[i], event.adc[i]);
+    }
+    for (int i = 0; i < 5; ++i) {
+      Host::setPressed(kButtonPins[i], (event.buttons >> i) & 1);
+    }
+  }
+}
+
+uint32_t Session::durationMs() const {
+  return events.empty() ? 0 : events.back().ms + kSettleMs;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Input recorded on the transmitter with SESSION_RECORD (or written by
+// hand in the same format). Lines read "I <ms> <steer> <throttle>
+// <suspension> <buttons>"; anything else in the file, such as the rest of
+// a serial log, is skipped. Playback starts at the first event.
+class Session {
+public:
+  bool load(const char *path);
+
+  // Drives the pins to the last event at or before ms.
+  void apply(uint32_t ms);
+  // Time of the last event plus a second for the screen to settle.
+  uint32_t durationMs() const;
+
+private:
+  struct Event {
+    uint32_t ms;
+    uint16_t adc[3];
+    uint8_t buttons;
+  };
+
+  std::vector<Event> events;
+  size_t next = 0;
+};
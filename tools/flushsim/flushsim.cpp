@@ -0,0 +1,364 @@
+// Replays a recorded input session through the sketch on a host, with the
+// real PanelIO driving BusModel instead of the SPI peripheral, and reports
+// what every frame costs on the bus. Whenever a flush has finished, the
+// panel memory BusModel fed is checked against the sketch's framebuffer.
+// Build and usage: see README.md.
+
+#include <getopt.h>
+
+#include "BusModel.h"
+#include "Host.h"
+#include "PanelDriver.h"
+#include "PanelIO.h"
+#include "PanelRam.h"
+#include "Palette.h"
+#include "Session.h"
+
+namespace FlushSim {
+void checkPanel();
+}
+
+// The sketch's flushes pass through here so the bus model can split its
+// totals per frame. A frame opens at the first scroll or flush of a loop
+// pass; band mode flushes every band of a frame in the same pass.
+//
+// Once a flush or scroll has gone out, the first flushBusy() that finds
+// the panel idle checks it, before the sketch can touch the buffer again.
+namespace HostPanel {
+using namespace PanelIO;
+
+bool frameOpen = false;
+bool panelStale = false;
+// The colors an indexed flush went out with; the palette may change
+// before the check.
+uint16_t flushLut[COLOR_TOKEN_COUNT];
+
+void openFrame() {
+  if (frameOpen) return;
+  BusModel::beginFrame();
+  frameOpen = true;
+}
+
+bool beginFlush(const FlushRect *rects, uint16_t count, const uint16_t *buffer, int16_t stride,
+                int16_t originY = 0) {
+  openFrame();
+  panelStale = true;
+  return PanelIO::beginFlush(rects, count, buffer, stride, originY);
+}
+
+bool beginFlush(const FlushRect *rects, uint16_t count, const uint8_t *buffer, int16_t stride, const uint16_t *lut,
+                int16_t originY = 0) {
+  openFrame();
+  panelStale = true;
+  memcpy(flushLut, lut, sizeof(flushLut));
+  return PanelIO::beginFlush(rects, count, buffer, stride, lut, originY);
+}
+
+void scrollTo(int16_t offset) {
+  openFrame();
+  panelStale = true;
+  PanelIO::scrollTo(offset);
+}
+
+bool flushBusy() {
+  if (PanelIO::flushBusy()) return true;
+  if (panelStale) {
+    panelStale = false;
+    FlushSim::checkPanel();
+  }
+  return false;
+}
+}  // namespace HostPanel
+
+#define PanelIO HostPanel
+#include "TX.ino"
+#undef PanelIO
+
+namespace FlushSim {
+struct Totals {
+  uint32_t frames = 0;
+  uint64_t busyNs = 0;
+  uint64_t maxBusyNs = 0;
+  uint64_t setupNs = 0;
+  uint64_t stallNs = 0;
+  uint64_t bytes = 0;
+  uint64_t transactions = 0;
+  uint8_t maxQueued = 0;
+};
+
+struct PanelCheck {
+  uint32_t checks = 0;
+  uint32_t differing = 0;
+};
+
+Totals totals;
+PanelCheck panelCheck;
+bool verbose = false;
+uint64_t sessionStartNs = 0;
+
+double toMs(uint64_t ns) {
+  return ns / 1e6;
+}
+
+void recordFrame(const BusModel::Frame &frame) {
+  totals.frames++;
+  totals.busyNs += frame.busyNs;
+  if (frame.busyNs > totals.maxBusyNs) totals.maxBusyNs = frame.busyNs;
+  totals.setupNs += frame.setupNs;
+  totals.stallNs += frame.stallNs();
+  totals.bytes += frame.bytes;
+  totals.transactions += frame.transactions;
+  if (frame.maxQueued > totals.maxQueued) totals.maxQueued = frame.maxQueued;
+  if (verbose) {
+    printf("frame %5u  t=%8.1f ms  screen %2d  %6u bytes  %4u trans  bus %6.3f ms (setup %6.3f)  stall %6.3f ms\n",
+           totals.frames, toMs(frame.startNs - sessionStartNs), static_cast<int>(ui.currentScreen()), frame.bytes,
+           frame.transactions, toMs(frame.busyNs), toMs(frame.setupNs), toMs(frame.stallNs()));
+  }
+}
+
+uint32_t framesDrawn() {
+  uint32_t sum = 0;
+  for (uint8_t r = 0; r < UI_REGION_COUNT; ++r) {
+    sum += scheduler.stats().drawn[r];
+  }
+  return sum;
+}
+
+// Setup cost in pixels at the bus clock, the unit FlushPlanner weighs
+// rects and transactions in. An address window is five short transactions.
+uint32_t setupPx(uint64_t ns) {
+  return static_cast<uint32_t>(ns * BusModel::clockHz() / 16 / 1000000000ull);
+}
+
+// Compares every pixel of the frame the sketch holds as on the panel with
+// what the glass shows. Band mode keeps no whole frame to compare.
+void checkPanel() {
+#if !FRAME_BAND_ROWS
+  typedef PanelDriver<PanelModel, kWidth, kHeight> Driver;
+  static const uint32_t kReported = 5;
+  const FramePixel *frame = FRAME_SINGLE_BUFFER ? backBuffer : frontBuffer;
+  uint32_t differing = 0;
+  int16_t firstX = 0, firstY = 0;
+  uint16_t firstPanel = 0, firstFrame = 0;
+  for (int16_t y = 0; y < kHeight; ++y) {
+    for (int16_t x = 0; x < kWidth; ++x) {
+      uint16_t v = frame[static_cast<int32_t>(y) * kWidth + x];
+      if (FRAME_INDEXED) v = HostPanel::flushLut[v];
+      v = static_cast<uint16_t>((v << 8) | (v >> 8));
+      uint16_t shown = PanelRam::shown(x + Driver::kOriginX, y + Driver::kOriginY);
+      if (shown == v) continue;
+      if (differing++ == 0) {
+        firstX = x;
+        firstY = y;
+        firstPanel = shown;
+        firstFrame = v;
+      }
+    }
+  }
+  panelCheck.checks++;
+  if (differing == 0) return;
+  if (panelCheck.differing++ < kReported) {
+    fprintf(stderr, "flushsim: t=%.1f ms: panel differs from the frame in %u px, first (%d, %d): 0x%04x, frame 0x%04x\n",
+            toMs(Host::nowNs() - sessionStartNs), differing, firstX, firstY, firstPanel, firstFrame);
+  }
+#endif
+}
+
+#if RENDER_OVERDRAW
+const char *heatmapDir = nullptr;
+uint16_t heatmapsSeen = 0;
+
+// The sketch's overdraw map as an image: blue for one write, then green,
+// yellow, orange, red for five or more, over a quarter of the frame's luma
+// so the screen shows through. Band mode keeps no frame to show.
+void writeHeatmap(ScreenId screen) {
+  static const uint8_t kHeat[6][3] = {{0, 0, 0}, {0, 0, 170}, {0, 170, 0}, {200, 200, 0}, {230, 120, 0}, {255, 0, 0}};
+#if FRAME_BAND_ROWS
+  const FramePixel *frame = nullptr;
+#else
+  // Until its flush starts, the frame just drawn is still the back buffer.
+  const FramePixel *frame = (FRAME_SINGLE_BUFFER || framePending) ? backBuffer : frontBuffer;
+#endif
+  char path[512];
+  snprintf(path, sizeof(path), "%s/overdraw-%02u.ppm", heatmapDir, static_cast<unsigned>(screen));
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    fprintf(stderr, "flushsim: cannot write %s\n", path);
+    return;
+  }
+  fprintf(f, "P6\n%d %d\n255\n", overdraw.width(), overdraw.height());
+  for (int16_t y = 0; y < overdraw.height(); ++y) {
+    for (int16_t x = 0; x < overdraw.width(); ++x) {
+      uint8_t n = overdraw.at(x, y);
+      const uint8_t *heat = kHeat[n > 5 ? 5 : n];
+      uint32_t luma = 0;
+      if (frame) {
+        uint16_t v = frame[static_cast<int32_t>(y) * kWidth + x];
+        if (FRAME_INDEXED) v = palette.table()[v];
+        v = static_cast<uint16_t>((v << 8) | (v >> 8));
+        luma = (((v >> 11) & 31) * 8 * 3 + ((v >> 5) & 63) * 4 * 6 + (v & 31) * 8) / 10;
+      }
+      for (uint8_t c = 0; c < 3; ++c) {
+        fputc(static_cast<int>((heat[c] * 3 + luma) / 4), f);
+      }
+    }
+  }
+  fclose(f);
+}
+
+void printOverdraw() {
+  printf("overdraw: writes per px of the regions drawn, and each primitive's share\n");
+  for (uint8_t s = 0; s < SCREEN_COUNT; ++s) {
+    const OverdrawTotals &t = overdrawTotals[s];
+    if (t.frames == 0 || t.writes == 0) continue;
+    printf("  screen %2u  %5lu frames  %5.2f", s, static_cast<unsigned long>(t.frames),
+           static_cast<double>(t.writes) / (t.regionPixels ? t.regionPixels : 1));
+    for (uint8_t k = 0; k < OVERDRAW_KIND_COUNT; ++k) {
+      printf("  %s %3.0f%%", OverdrawMap::kindName(static_cast<OverdrawKind>(k)), 100.0 * t.kindWrites[k] / t.writes);
+    }
+    printf("\n");
+  }
+}
+#endif
+
+void usage() {
+  fprintf(stderr,
+          "usage: flushsim [-v] [-s] [-o file] [-t] [-l loop_us] [-r render_us] [-q queued_setup_us] [-p polled_setup_us]"
+          " [-m dir] session.txt\n"
+          "  -v  print every frame\n"
+          "  -s  copy the sketch's serial output to stderr\n"
+          "  -o  write the sketch's serial output to a file, e.g. a FRAME_MIRROR stream\n"
+          "  -t  print totals on one line: tile, session, frames, bus ms, stall ms, bytes,\n"
+          "      transactions, longest frame ms (sweep.sh reads these)\n"
+          "  -l  CPU time of a loop pass that draws nothing (default 400)\n"
+          "  -r  extra CPU time of a pass that draws (default 4000)\n"
+          "  -q  bus setup per queued transaction (default 13)\n"
+          "  -p  bus setup per polled transaction (default 2)\n"
+          "  -m  with RENDER_OVERDRAW, write each screen's overdraw heatmap to dir/overdraw-NN.ppm\n");
+}
+}  // namespace FlushSim
+
+int main(int argc, char **argv) {
+  using namespace FlushSim;
+  BusModel::Config config;
+  uint64_t loopNs = 400000;
+  uint64_t renderNs = 4000000;
+  bool table = false;
+  FILE *serialFile = nullptr;
+  int opt;
+  while ((opt = getopt(argc, argv, "vsto:l:r:q:p:m:")) != -1) {
+    switch (opt) {
+      case 'v':
+        verbose = true;
+        break;
+      case 's':
+        Host::setSerialOutput(stderr);
+        break;
+      case 'o':
+        serialFile = fopen(optarg, "wb");
+        if (!serialFile) {
+          fprintf(stderr, "flushsim: cannot write %s\n", optarg);
+          return 1;
+        }
+        Host::setSerialOutput(serialFile);
+        break;
+      case 't':
+        table = true;
+        break;
+      case 'l':
+        loopNs = static_cast<uint64_t>(atof(optarg) * 1000);
+        break;
+      case 'r':
+        renderNs = static_cast<uint64_t>(atof(optarg) * 1000);
+        break;
+      case 'q':
+        config.queuedSetupNs = static_cast<uint32_t>(atof(optarg) * 1000);
+        break;
+      case 'p':
+        config.polledSetupNs = static_cast<uint32_t>(atof(optarg) * 1000);
+        break;
+      case 'm':
+#if RENDER_OVERDRAW
+        heatmapDir = optarg;
+#else
+        fprintf(stderr, "flushsim: -m needs a build with RENDER_OVERDRAW 1\n");
+#endif
+        break;
+      default:
+        usage();
+        return 2;
+    }
+  }
+  if (optind != argc - 1) {
+    usage();
+    return 2;
+  }
+  Session session;
+  const char *path = argv[optind];
+  if (!session.load(path)) {
+    fprintf(stderr, "flushsim: no input events in %s\n", path);
+    return 1;
+  }
+
+  BusModel::configure(config);
+  BusModel::setFrameSink(recordFrame);
+  setup();
+  // Panel init and border clear are not part of any frame.
+  BusModel::discardFrame();
+
+  sessionStartNs = Host::nowNs();
+  uint64_t endNs = sessionStartNs + static_cast<uint64_t>(session.durationMs()) * 1000000;
+  while (Host::nowNs() < endNs) {
+    session.apply(static_cast<uint32_t>((Host::nowNs() - sessionStartNs) / 1000000));
+    uint32_t drawnBefore = framesDrawn();
+    HostPanel::frameOpen = false;
+    loop();
+    Host::advanceBy(loopNs);
+    if (framesDrawn() != drawnBefore) Host::advanceBy(renderNs);
+#if RENDER_OVERDRAW
+    if (overdrawMaps != heatmapsSeen) {
+      heatmapsSeen = overdrawMaps;
+      if (heatmapDir) writeHeatmap(overdrawScreen);
+    }
+#endif
+  }
+  PanelIO::waitFlush();
+  HostPanel::flushBusy();
+  BusModel::endFrame();
+  if (serialFile) fclose(serialFile);
+  bool panelOk = panelCheck.differing == 0 && BusModel::dcWritesDuringTransfers() == 0 && PanelRam::strayBytes() == 0;
+
+  double seconds = (Host::nowNs() - sessionStartNs) / 1e9;
+  uint32_t frames = totals.frames ? totals.frames : 1;
+  if (table) {
+    printf("%dx%d %s %u %.3f %.3f %llu %llu %.3f\n", FRAME_TILE_W, FRAME_TILE_H, path, totals.frames,
+           toMs(totals.busyNs), toMs(totals.stallNs), static_cast<unsigned long long>(totals.bytes),
+           static_cast<unsigned long long>(totals.transactions), toMs(totals.maxBusyNs));
+    return panelOk ? 0 : 1;
+  }
+  printf("%s: %.1f s, %u frames, tiles %dx%d\n", path, seconds, totals.frames, FRAME_TILE_W, FRAME_TILE_H);
+  printf("bus: %.1f MHz, queue %d (max used %u), setup %.1f us queued / %.1f us polled\n",
+         BusModel::clockHz() / 1e6, BusModel::queueDepth(), totals.maxQueued, config.queuedSetupNs / 1000.0,
+         config.polledSetupNs / 1000.0);
+  printf("per frame: %.3f ms on the bus (max %.3f, setup %.3f), %.0f bytes, %.1f transactions, %.3f ms stalled\n",
+         toMs(totals.busyNs) / frames, toMs(totals.maxBusyNs), toMs(totals.setupNs) / frames,
+         static_cast<double>(totals.bytes) / frames, static_cast<double>(totals.transactions) / frames,
+         toMs(totals.stallNs) / frames);
+  printf("bus busy %.1f%% of the session\n", 100.0 * toMs(totals.busyNs) / 1000.0 / seconds);
+  printf("panel: %u checks, %u differing from the frame, %u DC writes during transfers, %u stray data bytes\n",
+         panelCheck.checks, panelCheck.differing, BusModel::dcWritesDuringTransfers(), PanelRam::strayBytes());
+#if FRAME_MIRROR
+  const FrameMirror::Stats &mirrored = mirror.stats();
+  printf("mirror: %lu of %lu frames sent, %lu bytes at %.1f KB/s, %.1f:1 against raw tiles\n",
+         static_cast<unsigned long>(mirrored.framesSent), static_cast<unsigned long>(mirrored.framesFlushed),
+         static_cast<unsigned long>(mirrored.streamBytes), mirrored.streamBytes / 1024.0 / seconds,
+         mirrored.streamBytes ? static_cast<double>(mirrored.rawBytes) / mirrored.streamBytes : 0.0);
+#endif
+#if RENDER_OVERDRAW
+  printOverdraw();
+#endif
+  printf("planner costs at this setup: rect %u px, transaction %u px (planner uses %u / %u)\n",
+         setupPx(5ull * config.queuedSetupNs), setupPx(config.queuedSetupNs),
+         FlushPlanner::kRectSetupPx, FlushPlanner::kTransSetupPx);
+  return panelOk ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Just enough of the Arduino-ESP32 core for the sketch to build on a host.
+// Time is simulated (Host.h); pins read what the replayed session says.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROGMEM
+#define IRAM_ATTR
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+void pinMode(int pin, int mode);
+int digitalRead(int pin);
+void digitalWrite(int pin, int level);
+int analogRead(int pin);
+void analogReadResolution(int bits);
+
+struct HostSerial {
+  void setTxBufferSize(size_t size);
+  void begin(unsigned long baud);
+  size_t print(const char *text);
+  size_t println(const char *text);
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  size_t write(uint8_t byte);
+  size_t write(const uint8_t *data, size_t len);
+  int availableForWrite();
+};
+extern HostSerial Serial;
+
+struct HostEsp {
+  uint32_t getFreeHeap();
+  uint32_t getCycleCount();
+};
+extern HostEsp ESP;
@@ -0,0 +1,9 @@
+#pragma once
+
+// Settings are not persisted on the host; every read returns the default.
+class Preferences {
+public:
+  bool begin(const char *name, bool readOnly) { return true; }
+  int getInt(const char *key, int defaultValue) { return defaultValue; }
+  void putInt(const char *key, int value) {}
+};
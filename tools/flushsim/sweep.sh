@@ -0,0 +1,41 @@
+#!/bin/sh
+# Builds flushsim for each tile size, replays every session with each and
+# ranks the sizes by the time the flushes keep the bus busy or stalled.
+# Extra arguments go to flushsim, e.g. ./sweep.sh -q 8 for a faster driver.
+#
+# Sizes must divide the 128x160 frame into at most 512 tiles and 64 columns.
+cd "$(dirname "$0")" || exit 1
+
+TILES=${TILES:-"8x8 16x8 8x16 16x16 32x8 32x16 16x32 32x32 64x16 128x8 128x16"}
+SESSIONS=${SESSIONS:-sessions/*.txt}
+
+for tile in $TILES; do
+  make -s TILE="$tile" >/dev/null || exit 1
+done
+
+# Totals are collected before ranking so a failing run (flushsim exits 1
+# when the panel check fails) stops the sweep instead of ranking a size on
+# the sessions it got through.
+rows=
+for tile in $TILES; do
+  totals=
+  for session in $SESSIONS; do
+    line=$("build/$tile/flushsim" -t "$@" "$session") || {
+      echo "sweep: $tile failed on $session" >&2
+      exit 1
+    }
+    totals="$totals$line
+"
+  done
+  rows="$rows$(printf '%s' "$totals" | awk -v tile="$tile" '
+    { frames += $3; bus += $4; stall += $5; bytes += $6; trans += $7 }
+    END {
+      if (frames == 0) frames = 1
+      printf "%-8s %7d %10.3f %10.3f %10.0f %10.1f %9.3f\n", tile, frames, bus / frames, stall / frames,
+             bytes / frames, trans / frames, (bus + stall) / 1000
+    }')
+"
+done
+
+printf '%-8s %7s %10s %10s %10s %10s %9s\n' tile frames "bus ms/f" "stall/f" "bytes/f" "trans/f" "total s"
+printf '%s' "$rows" | sort -k7 -n | awk 'NR == 1 { best = $1 } { print } END { print "\nlowest bus + stall time: " best }'
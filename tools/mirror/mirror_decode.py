@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""Rebuilds TX screen frames from a FRAME_MIRROR serial stream.
+
+    mirror_decode.py capture.bin frames/            # PNG per frame
+    mirror_decode.py --ppm capture.bin frames/      # PPM instead
+    stty -F /dev/ttyUSB0 921600 raw && mirror_decode.py /dev/ttyUSB0 frames/
+
+The packet format is described in TX/FrameMirror.h. Bytes outside packets,
+such as boot messages, are skipped. Frames are written only once a
+keyframe has been seen and no packet since was lost. At the end the
+decoder reports compression against the raw tiles and stream bandwidth.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+SYNC = b"\xa5\x5a"
+MAX_PAYLOAD = 1024
+
+SKIP, FILL, LITERAL = 0x00, 0x40, 0x80
+
+
+class Mirror:
+    def __init__(self, out_dir, ppm):
+        self.out_dir = out_dir
+        self.ppm = ppm
+        self.width = self.height = 0
+        self.tile_w = self.tile_h = 0
+        self.frame = None
+        self.synced = False
+        self.written = 0
+        self.flushed = 0
+        self.frames = 0
+        self.raw_bytes = 0
+        self.packet_bytes = 0
+        self.bad_packets = 0
+        self.first_ms = None
+        self.last_ms = None
+        self.first_offset = self.last_offset = 0
+
+    def feed(self, data):
+        """Decodes every whole packet in data; returns the unused tail."""
+        pos = 0
+        while True:
+            start = data.find(SYNC, pos)
+            if start < 0:
+                return data[-1:] if data.endswith(SYNC[:1]) else b""
+            if len(data) - start < 5:
+                return data[start:]
+            kind = data[start + 2]
+            length = data[start + 3] | (data[start + 4] << 8)
+            if length > MAX_PAYLOAD:
+                pos = start + 1
+                continue
+            end = start + 5 + length + 1
+            if len(data) < end:
+                return data[start:]
+            payload = data[start + 5:end - 1]
+            if (sum(data[start + 2:end - 1]) & 0xFF) != data[end - 1]:
+                # A sync pair inside other bytes, or a damaged packet.
+                self.bad_packets += 1
+                self.synced = False
+                pos = start + 1
+                continue
+            self.packet_bytes += end - start
+            self.packet(kind, payload)
+            pos = end
+
+    def packet(self, kind, payload):
+        if kind == ord("H"):
+            self.width, self.height, self.tile_w, self.tile_h = struct.unpack("<HHBB", payload)
+            if self.frame is None or len(self.frame) != self.width * self.height:
+                self.frame = [0] * (self.width * self.height)
+            self.synced = True
+        elif kind == ord("T") and self.frame is not None:
+            self.tile(payload)
+        elif kind == ord("F"):
+            sequence, ms, flushed = struct.unpack("<HIH", payload)
+            if self.first_ms is None:
+                self.first_ms = ms
+                self.first_offset = self.packet_bytes
+            self.last_ms = ms
+            self.last_offset = self.packet_bytes
+            self.flushed += flushed
+            self.frames += 1
+            if self.synced:
+                self.write(sequence)
+
+    def tile(self, payload):
+        (index,) = struct.unpack_from("<H", payload)
+        tiles_x = (self.width + self.tile_w - 1) // self.tile_w
+        x0 = (index % tiles_x) * self.tile_w
+        y0 = (index // tiles_x) * self.tile_h
+        w = min(self.tile_w, self.width - x0)
+        h = min(self.tile_h, self.height - y0)
+        n, i, pos = w * h, 0, 2
+        while i < n and pos < len(payload):
+            token = payload[pos]
+            kind, run = token & 0xC0, (token & 0x3F) + 1
+            pos += 1
+            if kind == SKIP:
+                colors = None
+            elif kind == FILL:
+                colors = [(payload[pos] << 8) | payload[pos + 1]] * run
+                pos += 2
+            else:
+                colors = [(payload[pos + 2 * k] << 8) | payload[pos + 2 * k + 1] for k in range(run)]
+                pos += 2 * run
+            if colors is not None:
+                for k in range(run):
+                    p = i + k
+                    self.frame[(y0 + p // w) * self.width + x0 + p % w] = colors[k]
+            i += run
+        self.raw_bytes += n * 2
+
+    def write(self, sequence):
+        rgb = bytearray(self.width * self.height * 3)
+        for i, c in enumerate(self.frame):
+            r, g, b = (c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F
+            rgb[3 * i] = (r << 3) | (r >> 2)
+            rgb[3 * i + 1] = (g << 2) | (g >> 4)
+            rgb[3 * i + 2] = (b << 3) | (b >> 2)
+        name = os.path.join(self.out_dir, "frame_%05d_%05d.%s" % (self.written, sequence, "ppm" if self.ppm else "png"))
+        with open(name, "wb") as f:
+            f.write(ppm(self.width, self.height, rgb) if self.ppm else png(self.width, self.height, rgb))
+        self.written += 1
+
+    def report(self):
+        print("frames: %d written, %d complete in the stream, %d flushed on the TX (%d dropped)"
+              % (self.written, self.frames, self.flushed, max(0, self.flushed - self.frames)))
+        if self.packet_bytes:
+            print("compression: %d tile bytes sent as %d stream bytes, %.1f:1"
+                  % (self.raw_bytes, self.packet_bytes, self.raw_bytes / float(self.packet_bytes)))
+        if self.first_ms is not None and self.last_ms != self.first_ms:
+            seconds = ((self.last_ms - self.first_ms) & 0xFFFFFFFF) / 1000.0
+            rate = (self.last_offset - self.first_offset) / seconds
+            print("bandwidth: %.1f KB/s over %.1f s, %.1f frames/s"
+                  % (rate / 1024.0, seconds, (self.frames - 1) / seconds))
+        if self.bad_packets:
+            print("damaged packets: %d" % self.bad_packets)
+
+
+def ppm(width, height, rgb):
+    return b"P6\n%d %d\n255\n" % (width, height) + bytes(rgb)
+
+
+def png(width, height, rgb):
+    def chunk(kind, data):
+        body = kind + data
+        return struct.pack(">I", len(data)) + body + struct.pack(">I", zlib.crc32(body) & 0xFFFFFFFF)
+
+    stride = width * 3
+    rows = b"".join(b"\x00" + bytes(rgb[y * stride:(y + 1) * stride]) for y in range(height))
+    header = struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)
+    return b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", header) + chunk(b"IDAT", zlib.compress(rows)) + chunk(b"IEND", b"")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Rebuild TX screen frames from a FRAME_MIRROR stream.")
+    parser.add_argument("input", help="capture file, serial device, or - for stdin")
+    parser.add_argument("out_dir", help="directory for the frame images")
+    parser.add_argument("--ppm", action="store_true", help="write PPM instead of PNG")
+    args = parser.parse_args()
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    mirror = Mirror(args.out_dir, args.ppm)
+    source = sys.stdin.buffer if args.input == "-" else open(args.input, "rb", buffering=0)
+    tail = b""
+    try:
+        while True:
+            data = source.read(4096)
+            if not data:
+                break
+            tail = mirror.feed(tail + data)
+    except KeyboardInterrupt:
+        pass
+    mirror.report()
+
+
+if __name__ == "__main__":
+    main()